@@ -3,6 +3,7 @@
 
 #include "Characters/Abilities/AbilityTasks/GSAT_ServerWaitForClientTargetData.h"
 #include "AbilitySystemComponent.h"
+#include "Characters/Abilities/GSGATA_Trace.h"
 
 UGSAT_ServerWaitForClientTargetData::UGSAT_ServerWaitForClientTargetData(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -10,10 +11,11 @@ UGSAT_ServerWaitForClientTargetData::UGSAT_ServerWaitForClientTargetData(const F
 
 }
 
-UGSAT_ServerWaitForClientTargetData* UGSAT_ServerWaitForClientTargetData::ServerWaitForClientTargetData(UGameplayAbility* OwningAbility, FName TaskInstanceName, bool TriggerOnce)
+UGSAT_ServerWaitForClientTargetData* UGSAT_ServerWaitForClientTargetData::ServerWaitForClientTargetData(UGameplayAbility* OwningAbility, FName TaskInstanceName, bool TriggerOnce, AGameplayAbilityTargetActor* InTargetActor)
 {
 	UGSAT_ServerWaitForClientTargetData* MyObj = NewAbilityTask<UGSAT_ServerWaitForClientTargetData>(OwningAbility, TaskInstanceName);
 	MyObj->bTriggerOnce = TriggerOnce;
+	MyObj->TargetActor = InTargetActor;
 	return MyObj;
 }
 
@@ -24,6 +26,12 @@ void UGSAT_ServerWaitForClientTargetData::Activate()
 		return;
 	}
 
+	if (TargetActor)
+	{
+		TargetActor->OwningAbility = Ability;
+		TargetActor->SourceActor = Ability->GetCurrentActorInfo()->AvatarActor.Get();
+	}
+
 	FGameplayAbilitySpecHandle	SpecHandle = GetAbilitySpecHandle();
 	FPredictionKey ActivationPredictionKey = GetActivationPredictionKey();
 	AbilitySystemComponent->AbilityTargetDataSetDelegate(SpecHandle, ActivationPredictionKey).AddUObject(this, &UGSAT_ServerWaitForClientTargetData::OnTargetDataReplicatedCallback);
@@ -34,7 +42,25 @@ void UGSAT_ServerWaitForClientTargetData::OnTargetDataReplicatedCallback(const F
 	FGameplayAbilityTargetDataHandle MutableData = Data;
 	AbilitySystemComponent->ConsumeClientReplicatedTargetData(GetAbilitySpecHandle(), GetActivationPredictionKey());
 
-	if (ShouldBroadcastAbilityTaskDelegates())
+	bool bValidData = true;
+	AGSGATA_Trace* TraceTargetActor = Cast<AGSGATA_Trace>(TargetActor);
+
+	if (TraceTargetActor)
+	{
+		bValidData = TraceTargetActor->VerifyReplicatedTargetData(MutableData);
+	}
+	else if (FGSGameplayAbilityTargetData_SpreadShot::ContainsSpreadShot(MutableData))
+	{
+		// Without the trace target actor the shot can't be regenerated, its replicated hit results are empty
+		UE_LOG(LogTemp, Warning, TEXT("%s() Rejected a spread shot in %s, ServerWaitForClientTargetData needs the AGSGATA_Trace target actor that fired it"), *FString(__FUNCTION__), *GetNameSafe(Ability));
+		bValidData = false;
+	}
+	else if (TargetActor)
+	{
+		bValidData = TargetActor->OnReplicatedTargetDataReceived(MutableData);
+	}
+
+	if (bValidData && ShouldBroadcastAbilityTaskDelegates())
 	{
 		ValidData.Broadcast(MutableData);
 	}
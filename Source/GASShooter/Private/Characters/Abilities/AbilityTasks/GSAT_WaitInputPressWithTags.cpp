@@ -3,6 +3,8 @@
 
 #include "Characters\Abilities\AbilityTasks\GSAT_WaitInputPressWithTags.h"
 #include "AbilitySystemComponent.h"
+#include "Characters/Abilities/GSAbilitySystemComponent.h"
+#include "Characters/Abilities/GSAbilitySystemGlobals.h"
 
 UGSAT_WaitInputPressWithTags::UGSAT_WaitInputPressWithTags(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -65,8 +67,9 @@ void UGSAT_WaitInputPressWithTags::OnPressCallback()
 
 	//TODO extend tag query to support this and move this into it
 	// Hardcoded for GA_InteractPassive to ignore input while already interacting
-	if (AbilitySystemComponent->GetTagCount(FGameplayTag::RequestGameplayTag("State.Interacting"))
-		> AbilitySystemComponent->GetTagCount(FGameplayTag::RequestGameplayTag("State.InteractingRemoval")))
+	UGSAbilitySystemComponent* GSASC = Cast<UGSAbilitySystemComponent>(AbilitySystemComponent);
+	const UGSAbilitySystemGlobals& Globals = UGSAbilitySystemGlobals::GSGet();
+	if (GSASC ? GSASC->IsInteracting() : AbilitySystemComponent->GetTagCount(Globals.InteractingTag) > AbilitySystemComponent->GetTagCount(Globals.InteractingRemovalTag))
 	{
 		Reset();
 		return;
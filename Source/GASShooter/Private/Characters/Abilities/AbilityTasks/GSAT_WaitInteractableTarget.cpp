@@ -2,7 +2,6 @@
 
 
 #include "Characters/Abilities/AbilityTasks/GSAT_WaitInteractableTarget.h"
-#include "Characters/Abilities/GSInteractable.h"
 #include "Characters/Heroes/GSHeroCharacter.h"
 #include "DrawDebugHelpers.h"
 #include "GSBlueprintFunctionLibrary.h"
@@ -11,15 +10,26 @@
 UGSAT_WaitInteractableTarget::UGSAT_WaitInteractableTarget(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-	bTraceAffectsAimPitch = true;
+	FocusedTimerPeriod = 0.05f;
+	ConeHalfAngle = 5.0f;
+	ViewLocationThreshold = 1.0f;
+	ViewRotationThreshold = 0.25f;
+	MaxSkipDuration = 0.5f;
+
+	bHasScanned = false;
+	bFocused = false;
+	LastScanChangeSerial = 0;
+	LastScanTime = 0.0f;
 }
 
-UGSAT_WaitInteractableTarget* UGSAT_WaitInteractableTarget::WaitForInteractableTarget(UGameplayAbility* OwningAbility, FName TaskInstanceName, FCollisionProfileName TraceProfile, float MaxRange, float TimerPeriod, bool bShowDebug)
+UGSAT_WaitInteractableTarget* UGSAT_WaitInteractableTarget::WaitForInteractableTarget(UGameplayAbility* OwningAbility, FName TaskInstanceName, FCollisionProfileName TraceProfile, float MaxRange, float TimerPeriod, float FocusedTimerPeriod, float ConeHalfAngle, bool bShowDebug)
 {
 	UGSAT_WaitInteractableTarget* MyObj = NewAbilityTask<UGSAT_WaitInteractableTarget>(OwningAbility, TaskInstanceName);		//Register for task list here, providing a given FName as a key
 	MyObj->TraceProfile = TraceProfile;
 	MyObj->MaxRange = MaxRange;
 	MyObj->TimerPeriod = TimerPeriod;
+	MyObj->FocusedTimerPeriod = FocusedTimerPeriod;
+	MyObj->ConeHalfAngle = ConeHalfAngle;
 	MyObj->bShowDebug = bShowDebug;
 	
 	AGSHeroCharacter* Hero = Cast<AGSHeroCharacter>(OwningAbility->GetCurrentActorInfo()->AvatarActor);
@@ -52,108 +62,38 @@ void UGSAT_WaitInteractableTarget::OnDestroy(bool AbilityEnded)
 	Super::OnDestroy(AbilityEnded);
 }
 
-void UGSAT_WaitInteractableTarget::LineTrace(FHitResult& OutHitResult, const UWorld* World, const FVector& Start, const FVector& End, FName ProfileName, const FCollisionQueryParams Params, bool bLookForInteractableActor) const
+float UGSAT_WaitInteractableTarget::GetCurrentTimerPeriod() const
 {
-	check(World);
-
-	TArray<FHitResult> HitResults;
-	World->LineTraceMultiByProfile(HitResults, Start, End, ProfileName, Params);
-
-	OutHitResult.TraceStart = Start;
-	OutHitResult.TraceEnd = End;
-
-	for (int32 HitIdx = 0; HitIdx < HitResults.Num(); ++HitIdx)
-	{
-		const FHitResult& Hit = HitResults[HitIdx];
-
-		if (!Hit.Actor.IsValid() || Hit.Actor != Ability->GetCurrentActorInfo()->AvatarActor.Get())
-		{
-			// If bLookForInteractableActor is false, we're looking for an endpoint to trace to
-			if (bLookForInteractableActor && Hit.Actor.IsValid())
-			{
-				// bLookForInteractableActor is true, hit component must overlap COLLISION_INTERACTABLE trace channel
-				// This is so that a big Actor like a computer can have a small interactable button.
-				if (Hit.Component.IsValid() && Hit.Component.Get()->GetCollisionResponseToChannel(COLLISION_INTERACTABLE)
-					== ECollisionResponse::ECR_Overlap)
-				{
-					// Component/Actor must be available to interact
-					bool bIsInteractable = Hit.Actor.Get()->Implements<UGSInteractable>();
-
-					if (bIsInteractable && IGSInteractable::Execute_IsAvailableForInteraction(Hit.Actor.Get(), Hit.Component.Get()))
-					{
-						OutHitResult = Hit;
-						OutHitResult.bBlockingHit = true; // treat it as a blocking hit
-						return;
-					}
-				}
-
-				OutHitResult.TraceEnd = Hit.Location;
-				OutHitResult.bBlockingHit = false; // False means it isn't valid to interact with
-				return;
-			}
-
-			// This is for the first line trace to get an end point to trace to
-			// !Hit.Actor.IsValid() implies we didn't hit anything so return the endpoint as a blocking hit
-			// Or if we hit something else
-			OutHitResult = Hit;
-			OutHitResult.bBlockingHit = true; // treat it as a blocking hit
-			return;
-		}
-	}
+	return bFocused ? FocusedTimerPeriod : TimerPeriod;
 }
 
-void UGSAT_WaitInteractableTarget::AimWithPlayerController(const AActor* InSourceActor, FCollisionQueryParams Params, const FVector& TraceStart, FVector& OutTraceEnd, bool bIgnorePitch) const
+bool UGSAT_WaitInteractableTarget::CanSkipScan(const UGSInteractionSubsystem* InteractionSubsystem, const FVector& ViewLocation, const FRotator& ViewRotation, const FVector& RangeCenter) const
 {
-	if (!Ability) // Server and launching client only
+	if (!bHasScanned || GetWorld()->GetTimeSeconds() - LastScanTime >= MaxSkipDuration)
 	{
-		return;
+		return false;
 	}
 
-	APlayerController* PC = Ability->GetCurrentActorInfo()->PlayerController.Get();
-
-	// Default to TraceStart if no PlayerController
-	FVector ViewStart = TraceStart;
-	FRotator ViewRot(0.0f);
-	if (PC)
+	if (FVector::DistSquared(ViewLocation, LastViewLocation) > FMath::Square(ViewLocationThreshold)
+		|| !ViewRotation.Equals(LastViewRotation, ViewRotationThreshold))
 	{
-		PC->GetPlayerViewPoint(ViewStart, ViewRot);
+		return false;
 	}
 
-	const FVector ViewDir = ViewRot.Vector();
-	FVector ViewEnd = ViewStart + (ViewDir * MaxRange);
-
-	ClipCameraRayToAbilityRange(ViewStart, ViewDir, TraceStart, MaxRange, ViewEnd);
+	return !InteractionSubsystem->HasChangedSince(RangeCenter, MaxRange, LastScanChangeSerial);
+}
 
+bool UGSAT_WaitInteractableTarget::HasLineOfSight(const FVector& TraceStart, const FGSInteractableCandidate& Candidate, const FCollisionQueryParams& Params) const
+{
 	FHitResult HitResult;
-	LineTrace(HitResult, InSourceActor->GetWorld(), ViewStart, ViewEnd, TraceProfile.Name, Params, false);
 
-	const bool bUseTraceResult = HitResult.bBlockingHit && (FVector::DistSquared(TraceStart, HitResult.Location) <= (MaxRange * MaxRange));
-
-	const FVector AdjustedEnd = (bUseTraceResult) ? HitResult.Location : ViewEnd;
-
-	FVector AdjustedAimDir = (AdjustedEnd - TraceStart).GetSafeNormal();
-	if (AdjustedAimDir.IsZero())
-	{
-		AdjustedAimDir = ViewDir;
-	}
-
-	if (!bTraceAffectsAimPitch && bUseTraceResult)
+	if (!GetWorld()->LineTraceSingleByProfile(HitResult, TraceStart, Candidate.Location, TraceProfile.Name, Params))
 	{
-		FVector OriginalAimDir = (ViewEnd - TraceStart).GetSafeNormal();
-
-		if (!OriginalAimDir.IsZero())
-		{
-			// Convert to angles and use original pitch
-			const FRotator OriginalAimRot = OriginalAimDir.Rotation();
-
-			FRotator AdjustedAimRot = AdjustedAimDir.Rotation();
-			AdjustedAimRot.Pitch = OriginalAimRot.Pitch;
-
-			AdjustedAimDir = AdjustedAimRot.Vector();
-		}
+		return true;
 	}
 
-	OutTraceEnd = TraceStart + (AdjustedAimDir * MaxRange);
+	// Blocked by the interactable Actor itself
+	return HitResult.Actor.Get() == Candidate.Actor;
 }
 
 bool UGSAT_WaitInteractableTarget::ClipCameraRayToAbilityRange(FVector CameraLocation, FVector CameraDirection, FVector AbilityCenter, float AbilityRange, FVector& ClippedPosition) const
@@ -177,9 +117,6 @@ bool UGSAT_WaitInteractableTarget::ClipCameraRayToAbilityRange(FVector CameraLoc
 
 void UGSAT_WaitInteractableTarget::PerformTrace()
 {
-	bool bTraceComplex = false;
-	TArray<AActor*> ActorsToIgnore;
-
 	AActor* SourceActor = Ability->GetCurrentActorInfo()->AvatarActor.Get();
 	if (!SourceActor)
 	{
@@ -188,86 +125,118 @@ void UGSAT_WaitInteractableTarget::PerformTrace()
 		return;
 	}
 
-	ActorsToIgnore.Add(SourceActor);
+	UGSInteractionSubsystem* InteractionSubsystem = GetWorld()->GetSubsystem<UGSInteractionSubsystem>();
+	if (!InteractionSubsystem)
+	{
+		return;
+	}
 
-	// Check player's perspective, could be 1P or 3P
-	AGSHeroCharacter* Hero = Cast<AGSHeroCharacter>(SourceActor);
+	StartLocation = StartLocation3P;
 
-    StartLocation = StartLocation3P;
+	FVector TraceStart = StartLocation.GetTargetingTransform().GetLocation();
 
-	FCollisionQueryParams Params(SCENE_QUERY_STAT(AGameplayAbilityTargetActor_SingleLineTrace), bTraceComplex);
-	Params.bReturnPhysicalMaterial = true;
-	Params.AddIgnoredActors(ActorsToIgnore);
+	// Player view, effective on server and launching client only. Default to TraceStart if no PlayerController.
+	FVector ViewStart = TraceStart;
+	FRotator ViewRot = SourceActor->GetActorRotation();
 
-	// Calculate TraceEnd
-	FVector TraceStart = StartLocation.GetTargetingTransform().GetLocation();
-	FVector TraceEnd;
-	AimWithPlayerController(SourceActor, Params, TraceStart, TraceEnd); //Effective on server and launching client only
+	APlayerController* PC = Ability->GetCurrentActorInfo()->PlayerController.Get();
+	if (PC)
+	{
+		PC->GetPlayerViewPoint(ViewStart, ViewRot);
+	}
+
+	const FVector ViewDir = ViewRot.Vector();
+	FVector TraceEnd = ViewStart + (ViewDir * MaxRange);
+
+	// Nothing to do if the player didn't look around and nothing nearby changed
+	if (CanSkipScan(InteractionSubsystem, ViewStart, ViewRot, TraceStart))
+	{
+		return;
+	}
+
+	ClipCameraRayToAbilityRange(ViewStart, ViewDir, TraceStart, MaxRange, TraceEnd);
+
+	// Candidates in the view cone, nearest first
+	InteractionSubsystem->QueryCone(ViewStart, ViewDir, TraceStart, MaxRange, ConeHalfAngle, SourceActor, Candidates);
 
-	// ------------------------------------------------------
+	bHasScanned = true;
+	LastViewLocation = ViewStart;
+	LastViewRotation = ViewRot;
+	LastScanChangeSerial = InteractionSubsystem->GetChangeSerial();
+	LastScanTime = GetWorld()->GetTimeSeconds();
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(GSAT_WaitInteractableTarget), false);
+	Params.AddIgnoredActor(SourceActor);
 
 	FHitResult ReturnHitResult;
-	LineTrace(ReturnHitResult, GetWorld(), TraceStart, TraceEnd, TraceProfile.Name, Params, true);
-	
+	ReturnHitResult.TraceStart = TraceStart;
+	ReturnHitResult.TraceEnd = TraceEnd;
+
+	for (const FGSInteractableCandidate& Candidate : Candidates)
+	{
+		if (HasLineOfSight(TraceStart, Candidate, Params))
+		{
+			ReturnHitResult = FHitResult(Candidate.Actor, Candidate.Component, Candidate.Location, (TraceStart - Candidate.Location).GetSafeNormal());
+			ReturnHitResult.TraceStart = TraceStart;
+			ReturnHitResult.TraceEnd = Candidate.Location;
+			ReturnHitResult.bBlockingHit = true; // treat it as a blocking hit
+			break;
+		}
+	}
+
 	// Default to end of trace line if we don't hit a valid, available Interactable Actor
 	// bBlockingHit = valid, available Interactable Actor
 	if (!ReturnHitResult.bBlockingHit)
 	{
-		// No valid, available Interactable Actor
-
 		ReturnHitResult.Location = TraceEnd;
-		if (TargetData.Num() > 0 && TargetData.Get(0)->GetHitResult()->Actor.Get())
+	}
+
+	// Targets are identified by Actor and component, TargetData is only rebuilt and broadcast on a real transition
+	AActor* NewTargetActor = ReturnHitResult.bBlockingHit ? ReturnHitResult.Actor.Get() : nullptr;
+	UPrimitiveComponent* NewTargetComponent = ReturnHitResult.bBlockingHit ? ReturnHitResult.Component.Get() : nullptr;
+
+	if (NewTargetActor != TargetActor.Get() || NewTargetComponent != TargetComponent.Get() || TargetData.Num() < 1)
+	{
+		if (TargetActor.IsValid())
 		{
-			// Previous trace had a valid Interactable Actor, now we don't have one
+			// Previous trace had a valid Interactable Actor, now we have a different one or none
 			// Broadcast last valid target
 			LostInteractableTarget.Broadcast(TargetData);
 		}
 
 		TargetData = MakeTargetData(ReturnHitResult);
-	}
-	else
-	{
-		// Valid, available Interactable Actor
+		TargetActor = NewTargetActor;
+		TargetComponent = NewTargetComponent;
 
-		bool bBroadcastNewTarget = true;
-
-		if (TargetData.Num() > 0)
-		{
-			const AActor* OldTarget = TargetData.Get(0)->GetHitResult()->Actor.Get();
-
-			if (OldTarget == ReturnHitResult.Actor.Get())
-			{
-				// Old target is the same as the new target, don't broadcast the target
-				bBroadcastNewTarget = false;
-			}
-			else if (OldTarget)
-			{
-				// Old target exists and is different from the new target
-				// Broadcast last valid target
-				LostInteractableTarget.Broadcast(TargetData);
-			}
-		}
-
-		if (bBroadcastNewTarget)
+		if (NewTargetActor)
 		{
 			// Broadcast new valid target
-			TargetData = MakeTargetData(ReturnHitResult);
 			FoundNewInteractableTarget.Broadcast(TargetData);
 		}
 	}
 
+	// Poll faster while an interactable is in focus for responsive prompts
+	if (bFocused != ReturnHitResult.bBlockingHit)
+	{
+		bFocused = ReturnHitResult.bBlockingHit;
+		GetWorld()->GetTimerManager().SetTimer(TraceTimerHandle, this, &UGSAT_WaitInteractableTarget::PerformTrace, GetCurrentTimerPeriod(), true);
+	}
+
 #if ENABLE_DRAW_DEBUG
 	if (bShowDebug)
 	{
-		DrawDebugLine(GetWorld(), TraceStart, TraceEnd, FColor::Green, false, TimerPeriod);
+		// Skipped scans keep the last debug shapes alive
+		const float DebugLifeTime = FMath::Max(GetCurrentTimerPeriod(), MaxSkipDuration);
+
+		DrawDebugLine(GetWorld(), TraceStart, TraceEnd, FColor::Green, false, DebugLifeTime);
 		
 		if (ReturnHitResult.bBlockingHit)
 		{
-			DrawDebugSphere(GetWorld(), ReturnHitResult.Location, 20.0f, 16, FColor::Red, false, TimerPeriod);
+			DrawDebugSphere(GetWorld(), ReturnHitResult.Location, 20.0f, 16, FColor::Red, false, DebugLifeTime);
 		}
 		else
 		{
-			DrawDebugSphere(GetWorld(), ReturnHitResult.TraceEnd, 20.0f, 16, FColor::Green, false, TimerPeriod);
+			DrawDebugSphere(GetWorld(), ReturnHitResult.TraceEnd, 20.0f, 16, FColor::Green, false, DebugLifeTime);
 		}
 	}
 #endif // ENABLE_DRAW_DEBUG
@@ -3,6 +3,7 @@
 
 #include "Characters/Abilities/AbilityTasks/GSAT_WaitTargetDataUsingActor.h"
 #include "AbilitySystemComponent.h"
+#include "Characters/Abilities/GSAbilitySystemComponent.h"
 #include "Characters/Abilities/GSGATA_Trace.h"
 
 UGSAT_WaitTargetDataUsingActor::UGSAT_WaitTargetDataUsingActor(const FObjectInitializer& ObjectInitializer)
@@ -54,7 +55,25 @@ void UGSAT_WaitTargetDataUsingActor::OnTargetDataReplicatedCallback(const FGamep
 	 *	explicitly, the client is basically just sending a 'confirm' and the server is now going to do the work
 	 *	in OnReplicatedTargetDataReceived.
 	 */
-	if (TargetActor && !TargetActor->OnReplicatedTargetDataReceived(MutableData))
+	bool bValidData = true;
+	AGSGATA_Trace* TraceTargetActor = Cast<AGSGATA_Trace>(TargetActor);
+
+	if (TraceTargetActor)
+	{
+		bValidData = TraceTargetActor->VerifyReplicatedTargetData(MutableData);
+	}
+	else if (FGSGameplayAbilityTargetData_SpreadShot::ContainsSpreadShot(MutableData))
+	{
+		// Without the trace target actor the shot can't be regenerated, its replicated hit results are empty
+		UE_LOG(LogTemp, Warning, TEXT("%s() Rejected a spread shot in %s, the target actor is not an AGSGATA_Trace"), *FString(__FUNCTION__), *GetNameSafe(Ability));
+		bValidData = false;
+	}
+	else if (TargetActor)
+	{
+		bValidData = TargetActor->OnReplicatedTargetDataReceived(MutableData);
+	}
+
+	if (!bValidData)
 	{
 		if (ShouldBroadcastAbilityTaskDelegates())
 		{
@@ -106,6 +125,8 @@ void UGSAT_WaitTargetDataUsingActor::OnTargetDataReadyCallback(const FGameplayAb
 		}
 		else if (ConfirmationType == EGameplayTargetingConfirmation::UserConfirmed)
 		{
+			FlushServerTargetDataBatch();
+
 			// We aren't going to send the target data, but we will send a generic confirmed message.
 			AbilitySystemComponent->ServerSetReplicatedEvent(EAbilityGenericReplicatedEvent::GenericConfirm, GetAbilitySpecHandle(), GetActivationPredictionKey(), AbilitySystemComponent->ScopedPredictionKey);
 		}
@@ -113,7 +134,8 @@ void UGSAT_WaitTargetDataUsingActor::OnTargetDataReadyCallback(const FGameplayAb
 
 	if (ShouldBroadcastAbilityTaskDelegates())
 	{
-		ValidData.Broadcast(Data);
+		// Spread shots are sent as is, but effects are applied per hit
+		ValidData.Broadcast(FGSGameplayAbilityTargetData_SpreadShot::ExpandHitResults(Data));
 	}
 
 	if (ConfirmationType != EGameplayTargetingConfirmation::CustomMulti)
@@ -130,6 +152,9 @@ void UGSAT_WaitTargetDataUsingActor::OnTargetDataCancelledCallback(const FGamepl
 
 	if (IsPredictingClient())
 	{
+		// Held TargetData must reach the server before the cancel
+		FlushServerTargetDataBatch();
+
 		if (!TargetActor->ShouldProduceTargetDataOnServer)
 		{
 			AbilitySystemComponent->ServerSetReplicatedTargetDataCancelled(GetAbilitySpecHandle(), GetActivationPredictionKey(), AbilitySystemComponent->ScopedPredictionKey);
@@ -174,6 +199,10 @@ void UGSAT_WaitTargetDataUsingActor::InitializeTargetActor() const
 
 	TargetActor->MasterPC = Ability->GetCurrentActorInfo()->PlayerController.Get();
 
+	// Replicated TargetData can arrive before StartTargeting() in FinalizeTargetActor()
+	TargetActor->OwningAbility = Ability;
+	TargetActor->SourceActor = Ability->GetCurrentActorInfo()->AvatarActor.Get();
+
 	// If we spawned the target actor, always register the callbacks for when the data is ready.
 	TargetActor->TargetDataReadyDelegate.AddUObject(const_cast<UGSAT_WaitTargetDataUsingActor*>(this), &UGSAT_WaitTargetDataUsingActor::OnTargetDataReadyCallback);
 	TargetActor->CanceledDelegate.AddUObject(const_cast<UGSAT_WaitTargetDataUsingActor*>(this), &UGSAT_WaitTargetDataUsingActor::OnTargetDataCancelledCallback);
@@ -263,6 +292,15 @@ void UGSAT_WaitTargetDataUsingActor::OnDestroy(bool AbilityEnded)
 	Super::OnDestroy(AbilityEnded);
 }
 
+void UGSAT_WaitTargetDataUsingActor::FlushServerTargetDataBatch() const
+{
+	UGSAbilitySystemComponent* GSASC = Cast<UGSAbilitySystemComponent>(AbilitySystemComponent);
+	if (GSASC)
+	{
+		GSASC->FlushServerTargetDataBatch();
+	}
+}
+
 bool UGSAT_WaitTargetDataUsingActor::ShouldReplicateDataToServer() const
 {
 	if (!Ability || !TargetActor)
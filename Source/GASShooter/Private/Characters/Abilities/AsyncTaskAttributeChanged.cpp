@@ -2,39 +2,40 @@
 
 
 #include "Characters/Abilities/AsyncTaskAttributeChanged.h"
+#include "Characters/Abilities/GSAbilitySystemComponent.h"
 
-UAsyncTaskAttributeChanged* UAsyncTaskAttributeChanged::ListenForAttributeChange(UAbilitySystemComponent* AbilitySystemComponent, FGameplayAttribute Attribute)
+UAsyncTaskAttributeChanged* UAsyncTaskAttributeChanged::ListenForAttributeChange(UAbilitySystemComponent* AbilitySystemComponent, FGameplayAttribute Attribute, bool bCoalescePerFrame)
 {
-	UAsyncTaskAttributeChanged* WaitForAttributeChangedTask = NewObject<UAsyncTaskAttributeChanged>();
-	WaitForAttributeChangedTask->ASC = AbilitySystemComponent;
-	WaitForAttributeChangedTask->AttributeToListenFor = Attribute;
-
-	if (!IsValid(AbilitySystemComponent) || !Attribute.IsValid())
-	{
-		WaitForAttributeChangedTask->RemoveFromRoot();
-		return nullptr;
-	}
-
-	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Attribute).AddUObject(WaitForAttributeChangedTask, &UAsyncTaskAttributeChanged::AttributeChanged);
+	return Listen(AbilitySystemComponent, MakeArrayView(&Attribute, 1), bCoalescePerFrame);
+}
 
-	return WaitForAttributeChangedTask;
+UAsyncTaskAttributeChanged * UAsyncTaskAttributeChanged::ListenForAttributesChange(UAbilitySystemComponent * AbilitySystemComponent, TArray<FGameplayAttribute> Attributes, bool bCoalescePerFrame)
+{
+	return Listen(AbilitySystemComponent, Attributes, bCoalescePerFrame);
 }
 
-UAsyncTaskAttributeChanged * UAsyncTaskAttributeChanged::ListenForAttributesChange(UAbilitySystemComponent * AbilitySystemComponent, TArray<FGameplayAttribute> Attributes)
+UAsyncTaskAttributeChanged* UAsyncTaskAttributeChanged::Listen(UAbilitySystemComponent* AbilitySystemComponent, TArrayView<const FGameplayAttribute> Attributes, bool bCoalescePerFrame)
 {
-	UAsyncTaskAttributeChanged* WaitForAttributeChangedTask = NewObject<UAsyncTaskAttributeChanged>();
-	WaitForAttributeChangedTask->ASC = AbilitySystemComponent;
-	WaitForAttributeChangedTask->AttributesToListenFor = Attributes;
+	UGSAbilitySystemComponent* GSASC = Cast<UGSAbilitySystemComponent>(AbilitySystemComponent);
 
-	if (!IsValid(AbilitySystemComponent) || Attributes.Num() < 1)
+	// Validate before creating the task so nothing is left behind on failure
+	if (!IsValid(GSASC) || Attributes.Num() < 1)
 	{
-		WaitForAttributeChangedTask->RemoveFromRoot();
 		return nullptr;
 	}
 
-	for (FGameplayAttribute Attribute : Attributes)
+	UAsyncTaskAttributeChanged* WaitForAttributeChangedTask = NewObject<UAsyncTaskAttributeChanged>();
+	WaitForAttributeChangedTask->ASC = AbilitySystemComponent;
+	WaitForAttributeChangedTask->ListenerHandle = GSASC->GetListenerHub().ListenForAttributes(
+		Attributes,
+		FGSAttributeListenerDelegate::CreateUObject(WaitForAttributeChangedTask, &UAsyncTaskAttributeChanged::AttributeChanged),
+		bCoalescePerFrame
+	);
+
+	if (!WaitForAttributeChangedTask->ListenerHandle.IsValid())
 	{
-		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Attribute).AddUObject(WaitForAttributeChangedTask, &UAsyncTaskAttributeChanged::AttributeChanged);
+		WaitForAttributeChangedTask->SetReadyToDestroy();
+		return nullptr;
 	}
 
 	return WaitForAttributeChangedTask;
@@ -42,21 +43,19 @@ UAsyncTaskAttributeChanged * UAsyncTaskAttributeChanged::ListenForAttributesChan
 
 void UAsyncTaskAttributeChanged::EndTask()
 {
-	if (IsValid(ASC))
-	{
-		ASC->GetGameplayAttributeValueChangeDelegate(AttributeToListenFor).RemoveAll(this);
+	UGSAbilitySystemComponent* GSASC = Cast<UGSAbilitySystemComponent>(ASC);
 
-		for (FGameplayAttribute Attribute : AttributesToListenFor)
-		{
-			ASC->GetGameplayAttributeValueChangeDelegate(Attribute).RemoveAll(this);
-		}
+	if (IsValid(GSASC))
+	{
+		GSASC->GetListenerHub().RemoveListener(ListenerHandle);
 	}
 
+	ListenerHandle.Reset();
+
 	SetReadyToDestroy();
-	MarkPendingKill();
 }
 
-void UAsyncTaskAttributeChanged::AttributeChanged(const FOnAttributeChangeData & Data)
+void UAsyncTaskAttributeChanged::AttributeChanged(const FGameplayAttribute& Attribute, float NewValue, float OldValue)
 {
-	OnAttributeChanged.Broadcast(Data.Attribute, Data.NewValue, Data.OldValue);
+	OnAttributeChanged.Broadcast(Attribute, NewValue, OldValue);
 }
\ No newline at end of file
@@ -2,46 +2,42 @@
 
 
 #include "Characters/Abilities/AsyncTaskGameplayTagAddedRemoved.h"
+#include "Characters/Abilities/GSAbilitySystemComponent.h"
 #include "GSBlueprintFunctionLibrary.h"
 
 UAsyncTaskGameplayTagAddedRemoved* UAsyncTaskGameplayTagAddedRemoved::ListenForGameplayTagAddedOrRemoved(UAbilitySystemComponent * AbilitySystemComponent, FGameplayTagContainer InTags)
 {
-	UAsyncTaskGameplayTagAddedRemoved* ListenForGameplayTagAddedRemoved = NewObject<UAsyncTaskGameplayTagAddedRemoved>();
-	ListenForGameplayTagAddedRemoved->ASC = AbilitySystemComponent;
-	ListenForGameplayTagAddedRemoved->Tags = InTags;
+	UGSAbilitySystemComponent* GSASC = Cast<UGSAbilitySystemComponent>(AbilitySystemComponent);
 
-	if (!IsValid(AbilitySystemComponent) || InTags.Num() < 1)
+	// Validate before creating the task so nothing is left behind on failure
+	if (!IsValid(GSASC) || InTags.Num() < 1)
 	{
-		ListenForGameplayTagAddedRemoved->EndTask();
 		return nullptr;
 	}
 
-	TArray<FGameplayTag> TagArray;
-	InTags.GetGameplayTagArray(TagArray);
-	
-	for (FGameplayTag Tag : TagArray)
-	{
-		AbilitySystemComponent->RegisterGameplayTagEvent(Tag, EGameplayTagEventType::NewOrRemoved).AddUObject(ListenForGameplayTagAddedRemoved, &UAsyncTaskGameplayTagAddedRemoved::TagChanged);
-	}
+	UAsyncTaskGameplayTagAddedRemoved* ListenForGameplayTagAddedRemoved = NewObject<UAsyncTaskGameplayTagAddedRemoved>();
+	ListenForGameplayTagAddedRemoved->ASC = AbilitySystemComponent;
+	ListenForGameplayTagAddedRemoved->Tags = InTags;
+	ListenForGameplayTagAddedRemoved->ListenerHandle = GSASC->GetListenerHub().ListenForGameplayTags(
+		InTags,
+		FGSGameplayTagListenerDelegate::CreateUObject(ListenForGameplayTagAddedRemoved, &UAsyncTaskGameplayTagAddedRemoved::TagChanged)
+	);
 
 	return ListenForGameplayTagAddedRemoved;
 }
 
 void UAsyncTaskGameplayTagAddedRemoved::EndTask()
 {
-	if (IsValid(ASC))
-	{
-		TArray<FGameplayTag> TagArray;
-		Tags.GetGameplayTagArray(TagArray);
+	UGSAbilitySystemComponent* GSASC = Cast<UGSAbilitySystemComponent>(ASC);
 
-		for (FGameplayTag Tag : TagArray)
-		{
-			ASC->RegisterGameplayTagEvent(Tag, EGameplayTagEventType::NewOrRemoved).RemoveAll(this);
-		}
+	if (IsValid(GSASC))
+	{
+		GSASC->GetListenerHub().RemoveListener(ListenerHandle);
 	}
 
+	ListenerHandle.Reset();
+
 	SetReadyToDestroy();
-	MarkPendingKill();
 }
 
 void UAsyncTaskGameplayTagAddedRemoved::TagChanged(const FGameplayTag Tag, int32 NewCount)
@@ -54,4 +50,4 @@ void UAsyncTaskGameplayTagAddedRemoved::TagChanged(const FGameplayTag Tag, int32
 	{
 		OnTagRemoved.Broadcast(Tag);
 	}
-}
+}
\ No newline at end of file
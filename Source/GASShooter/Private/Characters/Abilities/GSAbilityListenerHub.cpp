@@ -0,0 +1,309 @@
+// Copyright 2020 Dan Kestranek.
+
+
+#include "Characters/Abilities/GSAbilityListenerHub.h"
+#include "Characters/Abilities/GSAbilitySystemComponent.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+FGSAbilityListenerHub::FGSAbilityListenerHub(UGSAbilitySystemComponent* InOwner)
+	: Owner(InOwner)
+	, NextListenerId(1)
+	, bFlushScheduled(false)
+{
+}
+
+FGSAbilityListenerHub::~FGSAbilityListenerHub()
+{
+	// Bindings live in the owning ASC and are destroyed with it
+}
+
+FGSListenerHandle FGSAbilityListenerHub::ListenForAttributes(TArrayView<const FGameplayAttribute> Attributes, FGSAttributeListenerDelegate Delegate, bool bCoalescePerFrame)
+{
+	if (!IsValid(Owner) || !Delegate.IsBound())
+	{
+		return FGSListenerHandle();
+	}
+
+	FListener Listener;
+	Listener.AttributeDelegate = MoveTemp(Delegate);
+	Listener.bCoalesce = bCoalescePerFrame;
+
+	for (const FGameplayAttribute& Attribute : Attributes)
+	{
+		if (Attribute.IsValid())
+		{
+			Listener.Attributes.AddUnique(Attribute);
+		}
+	}
+
+	if (Listener.Attributes.Num() < 1)
+	{
+		return FGSListenerHandle();
+	}
+
+	const uint32 ListenerId = AddListener(MoveTemp(Listener));
+	const FListener& AddedListener = Listeners.FindChecked(ListenerId);
+
+	for (const FGameplayAttribute& Attribute : AddedListener.Attributes)
+	{
+		FAttributeChannel& Channel = AttributeChannels.FindOrAdd(Attribute);
+
+		// One ASC binding per attribute, shared by every listener
+		if (!Channel.BindingHandle.IsValid())
+		{
+			Channel.BindingHandle = Owner->GetGameplayAttributeValueChangeDelegate(Attribute).AddRaw(this, &FGSAbilityListenerHub::OnAttributeChanged);
+		}
+
+		Channel.ListenerIds.Add(ListenerId);
+
+		if (bCoalescePerFrame)
+		{
+			++Channel.NumCoalescedListeners;
+		}
+	}
+
+	return FGSListenerHandle(ListenerId);
+}
+
+FGSListenerHandle FGSAbilityListenerHub::ListenForGameplayTags(const FGameplayTagContainer& Tags, FGSGameplayTagListenerDelegate Delegate)
+{
+	if (!IsValid(Owner) || !Delegate.IsBound() || Tags.Num() < 1)
+	{
+		return FGSListenerHandle();
+	}
+
+	FListener Listener;
+	Listener.TagDelegate = MoveTemp(Delegate);
+	Tags.GetGameplayTagArray(Listener.Tags);
+
+	const uint32 ListenerId = AddListener(MoveTemp(Listener));
+	const FListener& AddedListener = Listeners.FindChecked(ListenerId);
+
+	for (const FGameplayTag& Tag : AddedListener.Tags)
+	{
+		FTagChannel& Channel = TagChannels.FindOrAdd(Tag);
+
+		// One ASC binding per tag, shared by every listener
+		if (!Channel.BindingHandle.IsValid())
+		{
+			Channel.BindingHandle = Owner->RegisterGameplayTagEvent(Tag, EGameplayTagEventType::NewOrRemoved).AddRaw(this, &FGSAbilityListenerHub::OnTagChanged);
+		}
+
+		Channel.ListenerIds.Add(ListenerId);
+	}
+
+	return FGSListenerHandle(ListenerId);
+}
+
+void FGSAbilityListenerHub::RemoveListener(FGSListenerHandle& Handle)
+{
+	FListener Listener;
+
+	if (!Handle.IsValid() || !Listeners.RemoveAndCopyValue(Handle.Id, Listener))
+	{
+		Handle.Reset();
+		return;
+	}
+
+	const bool bHasOwner = IsValid(Owner);
+
+	for (const FGameplayAttribute& Attribute : Listener.Attributes)
+	{
+		FAttributeChannel* Channel = AttributeChannels.Find(Attribute);
+
+		if (!Channel)
+		{
+			continue;
+		}
+
+		Channel->ListenerIds.Remove(Handle.Id);
+
+		if (Listener.bCoalesce)
+		{
+			--Channel->NumCoalescedListeners;
+		}
+
+		if (Channel->ListenerIds.Num() < 1)
+		{
+			if (bHasOwner)
+			{
+				Owner->GetGameplayAttributeValueChangeDelegate(Attribute).Remove(Channel->BindingHandle);
+			}
+
+			AttributeChannels.Remove(Attribute);
+		}
+	}
+
+	for (const FGameplayTag& Tag : Listener.Tags)
+	{
+		FTagChannel* Channel = TagChannels.Find(Tag);
+
+		if (!Channel)
+		{
+			continue;
+		}
+
+		Channel->ListenerIds.Remove(Handle.Id);
+
+		if (Channel->ListenerIds.Num() < 1)
+		{
+			if (bHasOwner)
+			{
+				Owner->RegisterGameplayTagEvent(Tag, EGameplayTagEventType::NewOrRemoved).Remove(Channel->BindingHandle);
+			}
+
+			TagChannels.Remove(Tag);
+		}
+	}
+
+	Handle.Reset();
+}
+
+void FGSAbilityListenerHub::FlushCoalescedChanges()
+{
+	bFlushScheduled = false;
+
+	struct FPendingChange
+	{
+		FGameplayAttribute Attribute;
+		float OldValue;
+		float NewValue;
+		TArray<uint32, TInlineAllocator<8>> ListenerIds;
+	};
+
+	// Gather first, listeners may add or remove listeners while being notified
+	TArray<FPendingChange, TInlineAllocator<8>> PendingChanges;
+
+	for (TPair<FGameplayAttribute, FAttributeChannel>& Pair : AttributeChannels)
+	{
+		FAttributeChannel& Channel = Pair.Value;
+
+		if (Channel.bHasPendingChange)
+		{
+			FPendingChange& Change = PendingChanges.AddDefaulted_GetRef();
+			Change.Attribute = Pair.Key;
+			Change.OldValue = Channel.PendingOldValue;
+			Change.NewValue = Channel.PendingNewValue;
+			Change.ListenerIds = Channel.ListenerIds;
+
+			Channel.bHasPendingChange = false;
+		}
+	}
+
+	for (const FPendingChange& Change : PendingChanges)
+	{
+		for (uint32 ListenerId : Change.ListenerIds)
+		{
+			const FListener* Listener = Listeners.Find(ListenerId);
+
+			if (Listener && Listener->bCoalesce)
+			{
+				Listener->AttributeDelegate.ExecuteIfBound(Change.Attribute, Change.NewValue, Change.OldValue);
+			}
+		}
+	}
+}
+
+uint32 FGSAbilityListenerHub::AddListener(FListener&& Listener)
+{
+	const uint32 ListenerId = NextListenerId++;
+
+	// Skip the invalid handle id on wrap around
+	if (NextListenerId == 0)
+	{
+		NextListenerId = 1;
+	}
+
+	Listeners.Add(ListenerId, MoveTemp(Listener));
+
+	return ListenerId;
+}
+
+void FGSAbilityListenerHub::OnAttributeChanged(const FOnAttributeChangeData& Data)
+{
+	FAttributeChannel* Channel = AttributeChannels.Find(Data.Attribute);
+
+	if (!Channel)
+	{
+		return;
+	}
+
+	if (Channel->NumCoalescedListeners > 0)
+	{
+		// Keep the oldest value of the frame
+		if (!Channel->bHasPendingChange)
+		{
+			Channel->bHasPendingChange = true;
+			Channel->PendingOldValue = Data.OldValue;
+		}
+
+		Channel->PendingNewValue = Data.NewValue;
+
+		ScheduleFlush();
+	}
+
+	// Copy, listeners may be removed while being notified
+	const TArray<uint32, TInlineAllocator<8>> ListenerIds(Channel->ListenerIds);
+
+	for (uint32 ListenerId : ListenerIds)
+	{
+		const FListener* Listener = Listeners.Find(ListenerId);
+
+		if (Listener && !Listener->bCoalesce)
+		{
+			Listener->AttributeDelegate.ExecuteIfBound(Data.Attribute, Data.NewValue, Data.OldValue);
+		}
+	}
+}
+
+void FGSAbilityListenerHub::OnTagChanged(const FGameplayTag Tag, int32 NewCount)
+{
+	FTagChannel* Channel = TagChannels.Find(Tag);
+
+	if (!Channel)
+	{
+		return;
+	}
+
+	// Copy, listeners may be removed while being notified
+	const TArray<uint32, TInlineAllocator<8>> ListenerIds(Channel->ListenerIds);
+
+	for (uint32 ListenerId : ListenerIds)
+	{
+		const FListener* Listener = Listeners.Find(ListenerId);
+
+		if (Listener)
+		{
+			Listener->TagDelegate.ExecuteIfBound(Tag, NewCount);
+		}
+	}
+}
+
+void FGSAbilityListenerHub::ScheduleFlush()
+{
+	if (bFlushScheduled)
+	{
+		return;
+	}
+
+	UWorld* World = IsValid(Owner) ? Owner->GetWorld() : nullptr;
+
+	if (!World)
+	{
+		FlushCoalescedChanges();
+		return;
+	}
+
+	bFlushScheduled = true;
+
+	TWeakObjectPtr<UGSAbilitySystemComponent> WeakOwner(Owner);
+
+	World->GetTimerManager().SetTimerForNextTick([WeakOwner]()
+	{
+		if (UGSAbilitySystemComponent* ASC = WeakOwner.Get())
+		{
+			ASC->GetListenerHub().FlushCoalescedChanges();
+		}
+	});
+}
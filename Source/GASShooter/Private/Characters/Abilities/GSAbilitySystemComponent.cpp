@@ -4,10 +4,13 @@
 #include "Characters/Abilities/GSAbilitySystemComponent.h"
 #include "AbilitySystemGlobals.h"
 #include "Animation/AnimInstance.h"
+#include "Characters/Abilities/GSAbilitySystemGlobals.h"
 #include "Characters/Abilities/GSGameplayAbility.h"
 #include "GameplayCueManager.h"
 #include "GSBlueprintFunctionLibrary.h"
 #include "Net/UnrealNetwork.h"
+#include "TimerManager.h"
+#include "UObject/UObjectIterator.h"
 #include "Weapons/GSWeapon.h"
 
 static TAutoConsoleVariable<float> CVarReplayMontageErrorThreshold(
@@ -16,7 +19,34 @@ static TAutoConsoleVariable<float> CVarReplayMontageErrorThreshold(
 	TEXT("Tolerance level for when montage playback position correction occurs in replays")
 );
 
+static TAutoConsoleVariable<float> CVarTargetDataBatchWindow(
+	TEXT("GS.ability.TargetDataBatchWindow"),
+	0.15f,
+	TEXT("Max seconds a predicting client holds TargetData sent outside of an activation batch to send consecutive shots in one RPC. The window is sized from the measured shot interval to fit GS.ability.TargetDataBatchMaxShots shots, shots further apart than about 2/3 of this are sent immediately. Delays server hit confirmation by up to this time. 0 sends TargetData immediately.")
+);
+
+static TAutoConsoleVariable<int32> CVarTargetDataBatchMaxShots(
+	TEXT("GS.ability.TargetDataBatchMaxShots"),
+	8,
+	TEXT("Number of shots that sends the TargetData batch before the batch window ends")
+);
+
+// Shots further apart than this are a new burst, the shot interval is measured again
+static const float GSTargetDataBurstGap = 1.0f;
+
+// Largest batch accepted by the server
+static const int32 GSMaxTargetDataBatchShots = 32;
+
 UGSAbilitySystemComponent::UGSAbilitySystemComponent()
+	: ListenerHub(this)
+	, CharacterState(EGSCharacterState::None)
+	, bCharacterStateTagEventsRegistered(false)
+	, PendingTargetDataBatchStartTime(0.0f)
+	, LastBatchableShotTime(-1.0f)
+	, BatchableShotInterval(0.0f)
+	, NumTargetDataShotsSent(0)
+	, NumTargetDataRPCsSent(0)
+	, TotalTargetDataBatchDelay(0.0)
 {
 }
 
@@ -55,10 +85,20 @@ void UGSAbilitySystemComponent::TickComponent(float DeltaTime, ELevelTick TickTy
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 }
 
+void UGSAbilitySystemComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Held shots would be lost with the batch timer
+	FlushServerTargetDataBatch();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void UGSAbilitySystemComponent::InitAbilityActorInfo(AActor* InOwnerActor, AActor* InAvatarActor)
 {
 	Super::InitAbilityActorInfo(InOwnerActor, InAvatarActor);
 
+	RegisterCharacterStateTagEvents();
+
 	LocalAnimMontageInfoForMeshes = TArray<FGameplayAbilityLocalAnimMontageForMesh>();
 	RepAnimMontageInfoForMeshes = TArray<FGameplayAbilityRepAnimMontageForMesh>();
 
@@ -98,40 +138,152 @@ void UGSAbilitySystemComponent::AbilityLocalInputPressed(int32 InputID)
 
 	// ---------------------------------------------------------
 
+	FlushServerTargetDataBatch();
+
+	FIndexedAbilitySpecArray* IndexedSpecs = AbilitySpecsByInputID.Find(InputID);
+	if (!IndexedSpecs)
+	{
+		return;
+	}
+
 	ABILITYLIST_SCOPE_LOCK();
-	for (FGameplayAbilitySpec& Spec : ActivatableAbilities.Items)
+	for (FIndexedAbilitySpec& IndexedSpec : *IndexedSpecs)
 	{
-		if (Spec.InputID == InputID)
+		FGameplayAbilitySpec* SpecPtr = FindIndexedAbilitySpec(IndexedSpec);
+		if (SpecPtr && SpecPtr->Ability)
 		{
-			if (Spec.Ability)
+			FGameplayAbilitySpec& Spec = *SpecPtr;
+			Spec.InputPressed = true;
+			if (Spec.IsActive())
 			{
-				Spec.InputPressed = true;
-				if (Spec.IsActive())
+				if (Spec.Ability->bReplicateInputDirectly && IsOwnerActorAuthoritative() == false)
 				{
-					if (Spec.Ability->bReplicateInputDirectly && IsOwnerActorAuthoritative() == false)
-					{
-						ServerSetInputPressed(Spec.Handle);
-					}
+					ServerSetInputPressed(Spec.Handle);
+				}
 
-					AbilitySpecInputPressed(Spec);
+				AbilitySpecInputPressed(Spec);
 
-					// Invoke the InputPressed event. This is not replicated here. If someone is listening, they may replicate the InputPressed event to the server.
-					InvokeReplicatedEvent(EAbilityGenericReplicatedEvent::InputPressed, Spec.Handle, Spec.ActivationInfo.GetActivationPredictionKey());
-				}
-				else
+				// Invoke the InputPressed event. This is not replicated here. If someone is listening, they may replicate the InputPressed event to the server.
+				InvokeReplicatedEvent(EAbilityGenericReplicatedEvent::InputPressed, Spec.Handle, Spec.ActivationInfo.GetActivationPredictionKey());
+			}
+			else
+			{
+				UGSGameplayAbility* GA = Cast<UGSGameplayAbility>(Spec.Ability);
+				if (GA && GA->bActivateOnInput)
 				{
-					UGSGameplayAbility* GA = Cast<UGSGameplayAbility>(Spec.Ability);
-					if (GA && GA->bActivateOnInput)
-					{
-						// Ability is not active, so try to activate it
-						TryActivateAbility(Spec.Handle);
-					}
+					// Ability is not active, so try to activate it
+					TryActivateAbility(Spec.Handle);
 				}
 			}
 		}
 	}
 }
 
+void UGSAbilitySystemComponent::AbilityLocalInputReleased(int32 InputID)
+{
+	// Shots fired while the input was held must reach the server before the release
+	FlushServerTargetDataBatch();
+
+	Super::AbilityLocalInputReleased(InputID);
+}
+
+void UGSAbilitySystemComponent::SetAimingTags(const FGameplayTag& InAimingTag, const FGameplayTag& InAimingRemovalTag)
+{
+	if (HasAimingTags(InAimingTag, InAimingRemovalTag))
+	{
+		return;
+	}
+
+	UnregisterCharacterStateTagEvent(AimingTag, AimingTagEventHandle);
+	UnregisterCharacterStateTagEvent(AimingRemovalTag, AimingRemovalTagEventHandle);
+
+	AimingTag = InAimingTag;
+	AimingRemovalTag = InAimingRemovalTag;
+
+	if (bCharacterStateTagEventsRegistered)
+	{
+		AimingTagEventHandle = RegisterCharacterStateTagEvent(AimingTag);
+		AimingRemovalTagEventHandle = RegisterCharacterStateTagEvent(AimingRemovalTag);
+	}
+
+	UpdateCharacterState();
+}
+
+void UGSAbilitySystemComponent::RegisterCharacterStateTagEvents()
+{
+	if (bCharacterStateTagEventsRegistered)
+	{
+		return;
+	}
+
+	bCharacterStateTagEventsRegistered = true;
+
+	const UGSAbilitySystemGlobals& Globals = UGSAbilitySystemGlobals::GSGet();
+	RegisterCharacterStateTagEvent(Globals.InteractingTag);
+	RegisterCharacterStateTagEvent(Globals.InteractingRemovalTag);
+	RegisterCharacterStateTagEvent(Globals.KnockedDownTag);
+	RegisterCharacterStateTagEvent(Globals.DeadTag);
+	AimingTagEventHandle = RegisterCharacterStateTagEvent(AimingTag);
+	AimingRemovalTagEventHandle = RegisterCharacterStateTagEvent(AimingRemovalTag);
+
+	// Tags can be added before the actor info is initialized
+	UpdateCharacterState();
+}
+
+FDelegateHandle UGSAbilitySystemComponent::RegisterCharacterStateTagEvent(const FGameplayTag& Tag)
+{
+	if (Tag.IsValid())
+	{
+		return RegisterGameplayTagEvent(Tag, EGameplayTagEventType::AnyCountChange).AddUObject(this, &UGSAbilitySystemComponent::CharacterStateTagChanged);
+	}
+
+	return FDelegateHandle();
+}
+
+void UGSAbilitySystemComponent::UnregisterCharacterStateTagEvent(const FGameplayTag& Tag, FDelegateHandle& Handle)
+{
+	if (Tag.IsValid() && Handle.IsValid())
+	{
+		RegisterGameplayTagEvent(Tag, EGameplayTagEventType::AnyCountChange).Remove(Handle);
+	}
+
+	Handle.Reset();
+}
+
+void UGSAbilitySystemComponent::CharacterStateTagChanged(const FGameplayTag Tag, int32 NewCount)
+{
+	UpdateCharacterState();
+}
+
+void UGSAbilitySystemComponent::UpdateCharacterState()
+{
+	const UGSAbilitySystemGlobals& Globals = UGSAbilitySystemGlobals::GSGet();
+
+	EGSCharacterState NewState = EGSCharacterState::None;
+
+	if (GetTagCount(Globals.InteractingTag) > GetTagCount(Globals.InteractingRemovalTag))
+	{
+		NewState |= EGSCharacterState::Interacting;
+	}
+
+	if (GetTagCount(Globals.KnockedDownTag) > 0)
+	{
+		NewState |= EGSCharacterState::KnockedDown;
+	}
+
+	if (GetTagCount(Globals.DeadTag) > 0)
+	{
+		NewState |= EGSCharacterState::Dead;
+	}
+
+	if (AimingTag.IsValid() && GetTagCount(AimingTag) > GetTagCount(AimingRemovalTag))
+	{
+		NewState |= EGSCharacterState::Aiming;
+	}
+
+	CharacterState = NewState;
+}
+
 int32 UGSAbilitySystemComponent::K2_GetTagCount(FGameplayTag TagToCheck) const
 {
 	return GetTagCount(TagToCheck);
@@ -139,20 +291,95 @@ int32 UGSAbilitySystemComponent::K2_GetTagCount(FGameplayTag TagToCheck) const
 
 FGameplayAbilitySpecHandle UGSAbilitySystemComponent::FindAbilitySpecHandleForClass(TSubclassOf<UGameplayAbility> AbilityClass, UObject* OptionalSourceObject)
 {
-	ABILITYLIST_SCOPE_LOCK();
-	for (FGameplayAbilitySpec& Spec : ActivatableAbilities.Items)
+	FIndexedAbilitySpecArray* IndexedSpecs = AbilitySpecsByClass.Find(*AbilityClass);
+	if (!IndexedSpecs)
 	{
-		TSubclassOf<UGameplayAbility> SpecAbilityClass = Spec.Ability->GetClass();
-		if (SpecAbilityClass == AbilityClass)
+		return FGameplayAbilitySpecHandle();
+	}
+
+	for (FIndexedAbilitySpec& IndexedSpec : *IndexedSpecs)
+	{
+		FGameplayAbilitySpec* Spec = FindIndexedAbilitySpec(IndexedSpec);
+		if (Spec && (!OptionalSourceObject || Spec->SourceObject == OptionalSourceObject))
 		{
-			if (!OptionalSourceObject || (OptionalSourceObject && Spec.SourceObject == OptionalSourceObject))
+			return Spec->Handle;
+		}
+	}
+
+	return FGameplayAbilitySpecHandle();
+}
+
+void UGSAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	Super::OnGiveAbility(AbilitySpec);
+
+	if (!AbilitySpec.Ability)
+	{
+		return;
+	}
+
+	AddIndexedAbilitySpec(AbilitySpecsByInputID.FindOrAdd(AbilitySpec.InputID), AbilitySpec.Handle);
+	AddIndexedAbilitySpec(AbilitySpecsByClass.FindOrAdd(AbilitySpec.Ability->GetClass()), AbilitySpec.Handle);
+}
+
+void UGSAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	auto RemoveIndexedAbilitySpec = [&AbilitySpec](auto& AbilitySpecsByKey, const auto& Key)
+	{
+		FIndexedAbilitySpecArray* IndexedSpecs = AbilitySpecsByKey.Find(Key);
+		if (IndexedSpecs)
+		{
+			IndexedSpecs->RemoveAll([&AbilitySpec](const FIndexedAbilitySpec& IndexedSpec)
+			{
+				return IndexedSpec.Handle == AbilitySpec.Handle;
+			});
+
+			if (IndexedSpecs->Num() == 0)
 			{
-				return Spec.Handle;
+				AbilitySpecsByKey.Remove(Key);
 			}
 		}
+	};
+
+	RemoveIndexedAbilitySpec(AbilitySpecsByInputID, AbilitySpec.InputID);
+
+	if (AbilitySpec.Ability)
+	{
+		RemoveIndexedAbilitySpec(AbilitySpecsByClass, AbilitySpec.Ability->GetClass());
 	}
 
-	return FGameplayAbilitySpecHandle();
+	Super::OnRemoveAbility(AbilitySpec);
+}
+
+void UGSAbilitySystemComponent::AddIndexedAbilitySpec(FIndexedAbilitySpecArray& IndexedSpecs, const FGameplayAbilitySpecHandle& Handle)
+{
+	// Replicated specs can be added again by fast array replication
+	const bool bAlreadyIndexed = IndexedSpecs.ContainsByPredicate([&Handle](const FIndexedAbilitySpec& IndexedSpec)
+	{
+		return IndexedSpec.Handle == Handle;
+	});
+
+	if (!bAlreadyIndexed)
+	{
+		IndexedSpecs.Add({ Handle, INDEX_NONE });
+	}
+}
+
+FGameplayAbilitySpec* UGSAbilitySystemComponent::FindIndexedAbilitySpec(FIndexedAbilitySpec& IndexedSpec)
+{
+	TArray<FGameplayAbilitySpec>& Items = ActivatableAbilities.Items;
+
+	if (Items.IsValidIndex(IndexedSpec.ItemIndex) && Items[IndexedSpec.ItemIndex].Handle == IndexedSpec.Handle)
+	{
+		return &Items[IndexedSpec.ItemIndex];
+	}
+
+	IndexedSpec.ItemIndex = Items.IndexOfByPredicate([&IndexedSpec](const FGameplayAbilitySpec& Spec)
+	{
+		return Spec.Handle == IndexedSpec.Handle;
+	});
+
+	return Items.IsValidIndex(IndexedSpec.ItemIndex) ? &Items[IndexedSpec.ItemIndex] : nullptr;
 }
 
 void UGSAbilitySystemComponent::K2_AddLooseGameplayTag(const FGameplayTag& GameplayTag, int32 Count)
@@ -199,6 +426,140 @@ bool UGSAbilitySystemComponent::BatchRPCTryActivateAbility(FGameplayAbilitySpecH
 	return AbilityActivated;
 }
 
+void UGSAbilitySystemComponent::CallServerTryActivateAbility(FGameplayAbilitySpecHandle AbilityToActivate, bool InputPressed, FPredictionKey PredictionKey)
+{
+	FlushServerTargetDataBatch();
+
+	Super::CallServerTryActivateAbility(AbilityToActivate, InputPressed, PredictionKey);
+}
+
+void UGSAbilitySystemComponent::CallServerSetReplicatedTargetData(FGameplayAbilitySpecHandle AbilityHandle, FPredictionKey AbilityOriginalPredictionKey, const FGameplayAbilityTargetDataHandle& ReplicatedTargetDataHandle, FGameplayTag ApplicationTag, FPredictionKey CurrentPredictionKey)
+{
+	const float MaxBatchWindow = CVarTargetDataBatchWindow.GetValueOnGameThread();
+	const int32 MaxShots = FMath::Clamp(CVarTargetDataBatchMaxShots.GetValueOnGameThread(), 1, GSMaxTargetDataBatchShots);
+
+	const FGameplayAbilitySpec* Spec = FindAbilitySpecFromHandle(AbilityHandle);
+	const UGSGameplayAbility* GSAbility = Spec ? Cast<UGSGameplayAbility>(Spec->Ability) : nullptr;
+	bool bCanBatch = GSAbility && GSAbility->bBatchServerTargetData && !IsOwnerActorAuthoritative() && GetWorld();
+
+	float BatchWindow = 0.0f;
+
+	if (bCanBatch)
+	{
+		// Measure the fire rate, the first shot of a burst has no interval yet
+		const float CurrentTime = GetWorld()->GetTimeSeconds();
+		const float ShotInterval = CurrentTime - LastBatchableShotTime;
+		BatchableShotInterval = (LastBatchableShotTime >= 0.0f && ShotInterval < GSTargetDataBurstGap) ? ShotInterval : 0.0f;
+		LastBatchableShotTime = CurrentTime;
+
+		// Hold the batch long enough for MaxShots shots at this fire rate plus half an interval of jitter.
+		// Batching only pays off if at least a second shot fits in the max window, otherwise it only adds delay.
+		BatchWindow = FMath::Min(BatchableShotInterval * (MaxShots - 0.5f), MaxBatchWindow);
+		bCanBatch = MaxShots > 1 && BatchableShotInterval > 0.0f && BatchableShotInterval * 1.5f <= MaxBatchWindow;
+	}
+
+	// TargetData of an activation batch (BatchRPCTryActivateAbility) goes with the activation
+	if (!bCanBatch || LocalServerAbilityRPCBatchData.FindByKey(AbilityHandle))
+	{
+		FlushServerTargetDataBatch();
+		Super::CallServerSetReplicatedTargetData(AbilityHandle, AbilityOriginalPredictionKey, ReplicatedTargetDataHandle, ApplicationTag, CurrentPredictionKey);
+
+		++NumTargetDataShotsSent;
+		++NumTargetDataRPCsSent;
+		return;
+	}
+
+	// A batch holds the shots of one activation
+	if (PendingTargetDataBatch.Shots.Num() > 0)
+	{
+		const bool bSameActivation = PendingTargetDataBatch.AbilitySpecHandle == AbilityHandle
+			&& PendingTargetDataBatch.ActivationPredictionKey == AbilityOriginalPredictionKey
+			&& PendingTargetDataBatch.ApplicationTag == ApplicationTag;
+
+		if (!bSameActivation)
+		{
+			FlushServerTargetDataBatch();
+		}
+	}
+
+	if (PendingTargetDataBatch.Shots.Num() == 0)
+	{
+		PendingTargetDataBatch.AbilitySpecHandle = AbilityHandle;
+		PendingTargetDataBatch.ActivationPredictionKey = AbilityOriginalPredictionKey;
+		PendingTargetDataBatch.ApplicationTag = ApplicationTag;
+		PendingTargetDataBatchStartTime = GetWorld()->GetTimeSeconds();
+
+		GetWorld()->GetTimerManager().SetTimer(TargetDataBatchTimerHandle, this, &UGSAbilitySystemComponent::FlushServerTargetDataBatch, BatchWindow, false);
+	}
+
+	FGSBatchedTargetData& Shot = PendingTargetDataBatch.Shots.AddDefaulted_GetRef();
+	Shot.PredictionKey = CurrentPredictionKey;
+	Shot.TargetData = ReplicatedTargetDataHandle;
+
+	if (PendingTargetDataBatch.Shots.Num() >= MaxShots)
+	{
+		FlushServerTargetDataBatch();
+	}
+}
+
+void UGSAbilitySystemComponent::CallServerEndAbility(FGameplayAbilitySpecHandle AbilityHandle, FGameplayAbilityActivationInfo ActivationInfo, FPredictionKey PredictionKey)
+{
+	FlushServerTargetDataBatch();
+
+	Super::CallServerEndAbility(AbilityHandle, ActivationInfo, PredictionKey);
+}
+
+void UGSAbilitySystemComponent::FlushServerTargetDataBatch()
+{
+	UWorld* World = GetWorld();
+	if (World)
+	{
+		World->GetTimerManager().ClearTimer(TargetDataBatchTimerHandle);
+	}
+
+	const int32 NumShots = PendingTargetDataBatch.Shots.Num();
+	if (NumShots == 0)
+	{
+		return;
+	}
+
+	NumTargetDataShotsSent += NumShots;
+	++NumTargetDataRPCsSent;
+
+	if (World)
+	{
+		// The first shot waited the longest, later shots less
+		TotalTargetDataBatchDelay += World->GetTimeSeconds() - PendingTargetDataBatchStartTime;
+	}
+
+	if (NumShots == 1)
+	{
+		const FGSBatchedTargetData& Shot = PendingTargetDataBatch.Shots[0];
+		ServerSetReplicatedTargetData(PendingTargetDataBatch.AbilitySpecHandle, PendingTargetDataBatch.ActivationPredictionKey, Shot.TargetData, PendingTargetDataBatch.ApplicationTag, Shot.PredictionKey);
+	}
+	else
+	{
+		ServerSetReplicatedTargetDataBatch(PendingTargetDataBatch);
+	}
+
+	PendingTargetDataBatch.Shots.Reset();
+}
+
+void UGSAbilitySystemComponent::ServerSetReplicatedTargetDataBatch_Implementation(const FGSServerTargetDataBatch& Batch)
+{
+	// Same as receiving each shot in its own RPC. Only abilities with bBatchServerTargetData are batched,
+	// they consume each shot as soon as it is set.
+	for (const FGSBatchedTargetData& Shot : Batch.Shots)
+	{
+		ServerSetReplicatedTargetData(Batch.AbilitySpecHandle, Batch.ActivationPredictionKey, Shot.TargetData, Batch.ApplicationTag, Shot.PredictionKey);
+	}
+}
+
+bool UGSAbilitySystemComponent::ServerSetReplicatedTargetDataBatch_Validate(const FGSServerTargetDataBatch& Batch)
+{
+	return Batch.Shots.Num() <= GSMaxTargetDataBatchShots;
+}
+
 void UGSAbilitySystemComponent::ExecuteGameplayCueLocal(const FGameplayTag GameplayCueTag, const FGameplayCueParameters& GameplayCueParameters)
 {
 	UAbilitySystemGlobals::Get().GetGameplayCueManager()->HandleGameplayCue(GetOwner(), GameplayCueTag, EGameplayCueEvent::Type::Executed, GameplayCueParameters);
@@ -959,3 +1320,47 @@ bool UGSAbilitySystemComponent::ServerCurrentMontageSetPlayRateForMesh_Validate(
 {
 	return true;
 }
+
+#if !UE_BUILD_SHIPPING
+
+// RPCs saved by TargetData batching on the predicting clients of the world
+static void GSAbilityTargetDataBatchStats(const TArray<FString>& Args, UWorld* World)
+{
+	const bool bReset = Args.Num() > 0 && Args[0] == TEXT("reset");
+
+	for (TObjectIterator<UGSAbilitySystemComponent> It; It; ++It)
+	{
+		UGSAbilitySystemComponent* ASC = *It;
+		if (ASC->GetWorld() != World || ASC->IsOwnerActorAuthoritative() || ASC->NumTargetDataShotsSent == 0)
+		{
+			continue;
+		}
+
+		const int32 NumShots = ASC->NumTargetDataShotsSent;
+		const int32 NumRPCs = ASC->NumTargetDataRPCsSent;
+
+		UE_LOG(LogTemp, Log, TEXT("GS.ability.TargetDataBatchStats: %s sent %d shots in %d RPCs (%.0f%% of unbatched), last shot interval %.3f s, first shot of a batch held %.1f ms on average"),
+			*GetNameSafe(ASC->GetOwner()),
+			NumShots,
+			NumRPCs,
+			100.0 * NumRPCs / NumShots,
+			ASC->BatchableShotInterval,
+			NumRPCs > 0 ? 1000.0 * ASC->TotalTargetDataBatchDelay / NumRPCs : 0.0
+			);
+
+		if (bReset)
+		{
+			ASC->NumTargetDataShotsSent = 0;
+			ASC->NumTargetDataRPCsSent = 0;
+			ASC->TotalTargetDataBatchDelay = 0.0;
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GSAbilityTargetDataBatchStatsCommand(
+	TEXT("GS.ability.TargetDataBatchStats"),
+	TEXT("Logs TargetData shots and the server RPCs they were sent in for the predicting clients of the world. Arguments: [reset]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&GSAbilityTargetDataBatchStats)
+	);
+
+#endif // !UE_BUILD_SHIPPING
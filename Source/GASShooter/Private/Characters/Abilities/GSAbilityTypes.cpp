@@ -4,6 +4,7 @@
 #include "Characters/Abilities/GSAbilityTypes.h"
 #include "AbilitySystemGlobals.h"
 #include "Characters/Abilities/GSAbilitySystemComponent.h"
+#include "Characters/Abilities/GSTargetDataArena.h"
 
 bool FGSGameplayEffectContainerSpec::HasValidEffects() const
 {
@@ -24,15 +25,13 @@ void FGSGameplayEffectContainerSpec::AddTargets(const TArray<FGameplayAbilityTar
 
 	for (const FHitResult& HitResult : HitResults)
 	{
-		FGameplayAbilityTargetData_SingleTargetHit* NewData = new FGameplayAbilityTargetData_SingleTargetHit(HitResult);
-		TargetData.Add(NewData);
+		FGSTargetDataArena::Add<FGameplayAbilityTargetData_SingleTargetHit>(TargetData, HitResult);
 	}
 
 	if (TargetActors.Num() > 0)
 	{
-		FGameplayAbilityTargetData_ActorArray* NewData = new FGameplayAbilityTargetData_ActorArray();
+		FGameplayAbilityTargetData_ActorArray* NewData = FGSTargetDataArena::Add<FGameplayAbilityTargetData_ActorArray>(TargetData);
 		NewData->TargetActorArray.Append(TargetActors);
-		TargetData.Add(NewData);
 	}
 }
 
@@ -40,3 +39,101 @@ void FGSGameplayEffectContainerSpec::ClearTargets()
 {
 	TargetData.Clear();
 }
+
+// Spread is replicated in hundredths of a degree, aim direction as compressed pitch and yaw
+
+static uint16 PackSpread(float Spread)
+{
+	return static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(Spread * 100.0f), 0, static_cast<int32>(MAX_uint16)));
+}
+
+static float UnpackSpread(uint16 PackedSpread)
+{
+	return PackedSpread * 0.01f;
+}
+
+static FVector UnpackAimDirection(uint16 Pitch, uint16 Yaw)
+{
+	return FRotator(FRotator::DecompressAxisFromShort(Pitch), FRotator::DecompressAxisFromShort(Yaw), 0.0f).Vector();
+}
+
+void FGSGameplayAbilityTargetData_SpreadShot::Quantize()
+{
+	TraceStart.X = FMath::RoundToFloat(TraceStart.X);
+	TraceStart.Y = FMath::RoundToFloat(TraceStart.Y);
+	TraceStart.Z = FMath::RoundToFloat(TraceStart.Z);
+
+	const FRotator AimRotation = AimDirection.Rotation();
+	AimDirection = UnpackAimDirection(FRotator::CompressAxisToShort(AimRotation.Pitch), FRotator::CompressAxisToShort(AimRotation.Yaw));
+
+	Spread = UnpackSpread(PackSpread(Spread));
+}
+
+FGameplayAbilityTargetDataHandle FGSGameplayAbilityTargetData_SpreadShot::ExpandHitResults(const FGameplayAbilityTargetDataHandle& Data)
+{
+	FGameplayAbilityTargetDataHandle ExpandedData;
+
+	for (const TSharedPtr<FGameplayAbilityTargetData>& TargetData : Data.Data)
+	{
+		if (!TargetData.IsValid() || TargetData->GetScriptStruct() != FGSGameplayAbilityTargetData_SpreadShot::StaticStruct())
+		{
+			ExpandedData.Data.Add(TargetData);
+			continue;
+		}
+
+		// The effect context holds one hit result, the damage execution reads its bone and distance per hit
+		for (const FHitResult& HitResult : static_cast<const FGSGameplayAbilityTargetData_SpreadShot*>(TargetData.Get())->HitResults)
+		{
+			FGSTargetDataArena::Add<FGameplayAbilityTargetData_SingleTargetHit>(ExpandedData, HitResult);
+		}
+	}
+
+	return ExpandedData;
+}
+
+bool FGSGameplayAbilityTargetData_SpreadShot::ContainsSpreadShot(const FGameplayAbilityTargetDataHandle& Data)
+{
+	for (const TSharedPtr<FGameplayAbilityTargetData>& TargetData : Data.Data)
+	{
+		if (TargetData.IsValid() && TargetData->GetScriptStruct() == FGSGameplayAbilityTargetData_SpreadShot::StaticStruct())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool FGSGameplayAbilityTargetData_SpreadShot::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	TraceStart.NetSerialize(Ar, Map, bOutSuccess);
+
+	uint16 AimPitch = 0;
+	uint16 AimYaw = 0;
+	uint16 PackedShotIndex = 0;
+	uint16 PackedSpread = 0;
+
+	if (Ar.IsSaving())
+	{
+		const FRotator AimRotation = AimDirection.Rotation();
+		AimPitch = FRotator::CompressAxisToShort(AimRotation.Pitch);
+		AimYaw = FRotator::CompressAxisToShort(AimRotation.Yaw);
+		PackedShotIndex = static_cast<uint16>(ShotIndex);
+		PackedSpread = PackSpread(Spread);
+	}
+
+	Ar << AimPitch;
+	Ar << AimYaw;
+	Ar << PackedShotIndex;
+	Ar << PackedSpread;
+
+	if (Ar.IsLoading())
+	{
+		AimDirection = UnpackAimDirection(AimPitch, AimYaw);
+		ShotIndex = PackedShotIndex;
+		Spread = UnpackSpread(PackedSpread);
+		HitResults.Reset();
+	}
+
+	return true;
+}
@@ -0,0 +1,113 @@
+// Copyright 2020 Dan Kestranek.
+
+
+#include "Characters/Abilities/GSCompiledTargetDataFilter.h"
+#include "Engine/CollisionProfile.h"
+
+FGSCompiledTargetDataFilter::FGSCompiledTargetDataFilter()
+{
+	Reset();
+}
+
+void FGSCompiledTargetDataFilter::Compile(
+	const FGameplayTargetDataFilterHandle& FilterHandle,
+	const AActor* Instigator,
+	FName InProfileName,
+	bool bInlineFilter,
+	bool bInFilterFriendlyFactions,
+	const TArray<TEnumAsByte<ECollisionChannel>>& FilteredObjectChannels)
+{
+	Reset();
+
+	SourceFilter = FilterHandle.Filter;
+	ProfileName = InProfileName;
+
+	if (const FGameplayTargetDataFilter* Filter = SourceFilter.Get())
+	{
+		if (bInlineFilter)
+		{
+			SelfActor = Filter->SelfActor;
+			RequiredActorClass = Filter->RequiredActorClass.Get();
+			SelfFilter = Filter->SelfFilter;
+			bReverseFilter = Filter->bReverseFilter;
+			bHasFilter = true;
+		}
+		else
+		{
+			// Not marked as a plain filter, it may be a subclass overriding FilterPassesForActor()
+			bHasVirtualFilter = true;
+		}
+	}
+
+	const IFactionAgentInterface* FactionAgent = Cast<IFactionAgentInterface>(Instigator);
+	if (bInFilterFriendlyFactions && FactionAgent)
+	{
+		InstigatorFaction = FactionAgent->GetFaction();
+		bFilterFriendlyFactions = !InstigatorFaction.IsNone();
+	}
+
+	// Same channel and responses as a query by profile, minus the filtered object channels
+	UCollisionProfile::GetChannelAndResponseParams(ProfileName, TraceChannel, ResponseParams);
+
+	for (const TEnumAsByte<ECollisionChannel>& Channel : FilteredObjectChannels)
+	{
+		ResponseParams.CollisionResponse.SetResponse(Channel, ECR_Ignore);
+	}
+
+	bCompiled = true;
+}
+
+void FGSCompiledTargetDataFilter::Reset()
+{
+	SourceFilter.Reset();
+	ProfileName = NAME_None;
+
+	SelfActor = nullptr;
+	RequiredActorClass = nullptr;
+	SelfFilter = ETargetDataFilterSelf::TDFS_Any;
+	bReverseFilter = false;
+	bHasFilter = false;
+	bHasVirtualFilter = false;
+
+	bFilterFriendlyFactions = false;
+	InstigatorFaction = FFaction();
+	FactionAttitudes.Reset();
+
+	TraceChannel = ECC_Visibility;
+	ResponseParams = FCollisionResponseParams::DefaultResponseParam;
+
+	bCompiled = false;
+}
+
+void FGSCompiledTargetDataFilter::AddIgnoredActors(FCollisionQueryParams& Params) const
+{
+	if (bHasFilter && !bReverseFilter && SelfFilter == ETargetDataFilterSelf::TDFS_NoSelf && SelfActor)
+	{
+		Params.AddIgnoredActor(SelfActor);
+	}
+}
+
+bool FGSCompiledTargetDataFilter::IsFriendly(const AActor* Actor)
+{
+	const IFactionAgentInterface* FactionAgent = Cast<IFactionAgentInterface>(Actor);
+	if (!FactionAgent)
+	{
+		return false;
+	}
+
+	const FFaction Faction = FactionAgent->GetFaction();
+
+	for (const FFactionAttitude& Attitude : FactionAttitudes)
+	{
+		if (Attitude.Faction == Faction)
+		{
+			return Attitude.bFriendly;
+		}
+	}
+
+	FFactionAttitude& Attitude = FactionAttitudes.AddDefaulted_GetRef();
+	Attitude.Faction = Faction;
+	Attitude.bFriendly = InstigatorFaction.GetAttitudeTowards(Faction) == ETeamAttitude::Friendly;
+
+	return Attitude.bFriendly;
+}
@@ -4,6 +4,7 @@
 #include "Characters/Abilities/GSDamageExecutionCalc.h"
 #include "Characters/Abilities/AttributeSets/GSAttributeSetBase.h"
 #include "Characters/Abilities/GSAbilitySystemComponent.h"
+#include "Weapons/GSUTProjectile.h"
 
 // Declare the attributes to capture and define how we want to capture them from the Source and Target.
 struct GSDamageStatics
@@ -80,6 +81,18 @@ void UGSDamageExecutionCalc::Execute_Implementation(const FGameplayEffectCustomE
 		MutableSpec->DynamicAssetTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Effect.Damage.HeadShot")));
 	}
 
+	// Radial damage from projectile explosions. The hit result holds the explosion origin and distance to the target.
+	if (AssetTags.HasTagExact(FGameplayTag::RequestGameplayTag(FName("Effect.Damage.Radial"))) && Hit)
+	{
+		const AGSUTProjectile* Projectile = Cast<AGSUTProjectile>(Spec.GetContext().GetEffectCauser());
+		if (Projectile)
+		{
+			float Momentum = 0.0f;
+			const FRadialDamageParams RadialParams = Projectile->GetDamageParams(nullptr, Hit->TraceStart, Momentum);
+			UnmitigatedDamage *= RadialParams.GetDamageScale(Hit->Distance);
+		}
+	}
+
 	float MitigatedDamage = (UnmitigatedDamage) * (100 / (100 + Armor));
 
 	if (MitigatedDamage > 0.f)
@@ -32,7 +32,8 @@ void AGSGATA_LineTrace::Configure(
 	float InTargetingSpreadIncrement,
 	float InTargetingSpreadMax,
 	int32 InMaxHitResultsPerTrace,
-	int32 InNumberOfTraces)
+	int32 InNumberOfTraces,
+	bool bInUseDeterministicSpread)
 {
 	StartLocation = InStartLocation;
 	AimingTag = InAimingTag;
@@ -57,6 +58,7 @@ void AGSGATA_LineTrace::Configure(
 	TargetingSpreadMax = InTargetingSpreadMax;
 	MaxHitResultsPerTrace = InMaxHitResultsPerTrace;
 	NumberOfTraces = InNumberOfTraces;
+	bUseDeterministicSpread = bInUseDeterministicSpread;
 
 	if (bUsePersistentHitResults)
 	{
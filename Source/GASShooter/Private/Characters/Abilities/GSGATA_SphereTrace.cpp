@@ -33,7 +33,8 @@ void AGSGATA_SphereTrace::Configure(
 	float InTargetingSpreadIncrement,
 	float InTargetingSpreadMax,
 	int32 InMaxHitResultsPerTrace,
-	int32 InNumberOfTraces)
+	int32 InNumberOfTraces,
+	bool bInUseDeterministicSpread)
 {
 	StartLocation = InStartLocation;
 	AimingTag = InAimingTag;
@@ -57,6 +58,7 @@ void AGSGATA_SphereTrace::Configure(
 	TargetingSpreadMax = InTargetingSpreadMax;
 	MaxHitResultsPerTrace = InMaxHitResultsPerTrace;
 	NumberOfTraces = InNumberOfTraces;
+	bUseDeterministicSpread = bInUseDeterministicSpread;
 
 	if (bUsePersistentHitResults)
 	{
@@ -69,7 +71,16 @@ void AGSGATA_SphereTrace::SphereTraceWithFilter(TArray<FHitResult>& OutHitResult
 	check(World);
 
 	TArray<FHitResult> HitResults;
-	World->SweepMultiByProfile(HitResults, Start, End, FQuat::Identity, ProfileName, FCollisionShape::MakeSphere(Radius), Params);
+	const bool bUseCompiledFilter = CompiledFilter.IsCompiledFor(FilterHandle, ProfileName);
+
+	if (bUseCompiledFilter)
+	{
+		World->SweepMultiByChannel(HitResults, Start, End, FQuat::Identity, CompiledFilter.GetTraceChannel(), FCollisionShape::MakeSphere(Radius), Params, CompiledFilter.GetResponseParams());
+	}
+	else
+	{
+		World->SweepMultiByProfile(HitResults, Start, End, FQuat::Identity, ProfileName, FCollisionShape::MakeSphere(Radius), Params);
+	}
 
 	TArray<FHitResult> FilteredHitResults;
 
@@ -80,7 +91,7 @@ void AGSGATA_SphereTrace::SphereTraceWithFilter(TArray<FHitResult>& OutHitResult
 	{
 		FHitResult& Hit = HitResults[HitIdx];
 
-		if (!Hit.Actor.IsValid() || FilterHandle.FilterPassesForActor(Hit.Actor))
+		if (!Hit.Actor.IsValid() || (bUseCompiledFilter ? CompiledFilter.PassesForActor(Hit.Actor.Get()) : FilterHandle.FilterPassesForActor(Hit.Actor)))
 		{
 			Hit.TraceStart = TraceStart;
 			Hit.TraceEnd = End;
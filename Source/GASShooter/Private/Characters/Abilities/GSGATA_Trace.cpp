@@ -3,10 +3,147 @@
 
 #include "Characters/Abilities/GSGATA_Trace.h"
 #include "AbilitySystemComponent.h"
+#include "Characters/Abilities/GSAbilitySystemComponent.h"
+#include "Characters/Abilities/GSTargetDataArena.h"
 #include "DrawDebugHelpers.h"
 #include "GameFramework/PlayerController.h"
 #include "GameplayAbilitySpec.h"
 
+FGSPersistentHitQueue::FGSPersistentHitQueue()
+	: Head(0)
+	, NumSlotsUsed(0)
+	, NumHitResults(0)
+{
+}
+
+void FGSPersistentHitQueue::Reset(int32 InCapacity)
+{
+	Slots.Reset();
+	Slots.SetNum(FMath::Max(InCapacity, 0));
+
+	ActorToSlot.Reset();
+	ActorToSlot.Reserve(Slots.Num());
+
+	Head = 0;
+	NumSlotsUsed = 0;
+	NumHitResults = 0;
+}
+
+void FGSPersistentHitQueue::Empty()
+{
+	for (FSlot& Slot : Slots)
+	{
+		Slot.HitResult = FHitResult();
+		Slot.Actor = nullptr;
+		Slot.bUsed = false;
+	}
+
+	ActorToSlot.Reset();
+
+	Head = 0;
+	NumSlotsUsed = 0;
+	NumHitResults = 0;
+}
+
+void FGSPersistentHitQueue::Add(const FHitResult& HitResult)
+{
+	if (Slots.Num() < 1)
+	{
+		return;
+	}
+
+	if (NumHitResults >= Slots.Num())
+	{
+		// Full, evict the oldest
+		RemoveSlot(Head);
+		TrimHoles();
+	}
+
+	if (NumSlotsUsed >= Slots.Num())
+	{
+		// No free slot after the newest HitResult, close the holes
+		Compact();
+	}
+
+	const int32 SlotIndex = GetSlotIndex(NumSlotsUsed);
+	FSlot& Slot = Slots[SlotIndex];
+	Slot.HitResult = HitResult;
+	Slot.Actor = HitResult.Actor.Get();
+	Slot.bUsed = true;
+
+	if (Slot.Actor)
+	{
+		ActorToSlot.Add(Slot.Actor, SlotIndex);
+	}
+
+	NumSlotsUsed++;
+	NumHitResults++;
+}
+
+TArray<FHitResult> FGSPersistentHitQueue::ToArray() const
+{
+	TArray<FHitResult> HitResults;
+	HitResults.Reserve(NumHitResults);
+
+	for (int32 Offset = 0; Offset < NumSlotsUsed; Offset++)
+	{
+		const FSlot& Slot = Slots[GetSlotIndex(Offset)];
+
+		if (Slot.bUsed)
+		{
+			HitResults.Add(Slot.HitResult);
+		}
+	}
+
+	return HitResults;
+}
+
+void FGSPersistentHitQueue::RemoveSlot(int32 SlotIndex)
+{
+	FSlot& Slot = Slots[SlotIndex];
+
+	if (Slot.Actor)
+	{
+		ActorToSlot.Remove(Slot.Actor);
+	}
+
+	Slot.Actor = nullptr;
+	Slot.bUsed = false;
+
+	NumHitResults--;
+}
+
+void FGSPersistentHitQueue::TrimHoles()
+{
+	while (NumSlotsUsed > 0 && !Slots[Head].bUsed)
+	{
+		Head = (Head + 1) % Slots.Num();
+		NumSlotsUsed--;
+	}
+
+	while (NumSlotsUsed > 0 && !Slots[GetSlotIndex(NumSlotsUsed - 1)].bUsed)
+	{
+		NumSlotsUsed--;
+	}
+
+	if (NumSlotsUsed == 0)
+	{
+		Head = 0;
+	}
+}
+
+void FGSPersistentHitQueue::Compact()
+{
+	TArray<FHitResult> HitResults = ToArray();
+
+	Empty();
+
+	for (const FHitResult& HitResult : HitResults)
+	{
+		Add(HitResult);
+	}
+}
+
 AGSGATA_Trace::AGSGATA_Trace()
 {
 	bDestroyOnConfirmation = false;
@@ -27,6 +164,14 @@ AGSGATA_Trace::AGSGATA_Trace()
 	TargetingSpreadMax = 0.0f;
 	CurrentTargetingSpread = 0.0f;
 	bUsePersistentHitResults = false;
+	bInlineFilter = false;
+	bFilterFriendlyFactions = false;
+	bUseDeterministicSpread = false;
+	MaxShotOriginError = 500.0f;
+	ShotActivationKey = 0;
+	NextShotIndex = 0;
+	ExpectedShotIndex = 0;
+	bReplayingShot = false;
 }
 
 void AGSGATA_Trace::ResetSpread()
@@ -43,18 +188,33 @@ void AGSGATA_Trace::ResetSpread()
 
 float AGSGATA_Trace::GetCurrentSpread() const
 {
-	float FinalSpread = BaseSpread + CurrentTargetingSpread;
+	return (BaseSpread + CurrentTargetingSpread) * GetAimingSpreadModifier();
+}
 
+float AGSGATA_Trace::GetAimingSpreadModifier() const
+{
 	if (bUseAimingSpreadMod && AimingTag.IsValid() && AimingRemovalTag.IsValid())
 	{
 		UAbilitySystemComponent* ASC = OwningAbility->GetCurrentActorInfo()->AbilitySystemComponent.Get();
+		UGSAbilitySystemComponent* GSASC = Cast<UGSAbilitySystemComponent>(ASC);
+
+		if (GSASC && GSASC->HasAimingTags(AimingTag, AimingRemovalTag))
+		{
+			return GSASC->IsAiming() ? AimingSpreadMod : 1.0f;
+		}
+
 		if (ASC && (ASC->GetTagCount(AimingTag) > ASC->GetTagCount(AimingRemovalTag)))
 		{
-			FinalSpread *= AimingSpreadMod;
+			return AimingSpreadMod;
 		}
 	}
 
-	return FinalSpread;
+	return 1.0f;
+}
+
+int32 AGSGATA_Trace::GetShotSeed(int32 ActivationKey, int32 ShotIndex)
+{
+	return static_cast<int32>(HashCombine(static_cast<uint32>(ActivationKey), static_cast<uint32>(ShotIndex)));
 }
 
 void AGSGATA_Trace::SetStartLocation(const FGameplayAbilityTargetingLocationInfo& InStartLocation)
@@ -82,6 +242,15 @@ void AGSGATA_Trace::StartTargeting(UGameplayAbility* Ability)
 	SourceActor = Ability->GetCurrentActorInfo()->AvatarActor.Get();
     SourcePawn = Cast<APawn>(SourceActor);
 
+	CompiledFilter.Compile(Filter, SourceActor, TraceProfile.Name, bInlineFilter, bFilterFriendlyFactions, FilteredObjectChannels);
+
+	// Spread reads the aiming state of the ASC instead of counting the aiming tags
+	UGSAbilitySystemComponent* GSASC = Cast<UGSAbilitySystemComponent>(Ability->GetCurrentActorInfo()->AbilitySystemComponent.Get());
+	if (GSASC && bUseAimingSpreadMod && AimingTag.IsValid() && AimingRemovalTag.IsValid())
+	{
+		GSASC->SetAimingTags(AimingTag, AimingRemovalTag);
+	}
+
 	// This is a lazy way of emptying and repopulating the ReticleActors.
 	// We could come up with a solution that reuses them.
 	DestroyReticleActors();
@@ -96,7 +265,7 @@ void AGSGATA_Trace::StartTargeting(UGameplayAbility* Ability)
 
 	if (bUsePersistentHitResults)
 	{
-		PersistentHitResults.Empty();
+		PersistentHitResults.Reset(FMath::Max(MaxHitResultsPerTrace, 1));
 	}
 }
 
@@ -106,7 +275,18 @@ void AGSGATA_Trace::ConfirmTargetingAndContinue()
 	if (SourceActor)
 	{
 		TArray<FHitResult> HitResults = PerformTrace(SourceActor);
-		FGameplayAbilityTargetDataHandle Handle = MakeTargetData(HitResults);
+		FGameplayAbilityTargetDataHandle Handle;
+
+		if (UsesDeterministicSpread())
+		{
+			Handle = MakeSpreadShotTargetData(HitResults);
+			NextShotIndex++;
+		}
+		else
+		{
+			Handle = MakeTargetData(HitResults);
+		}
+
 		TargetDataReadyDelegate.Broadcast(Handle);
 
 #if ENABLE_DRAW_DEBUG
@@ -146,6 +326,69 @@ void AGSGATA_Trace::CancelTargeting()
 	}
 }
 
+bool AGSGATA_Trace::VerifyReplicatedTargetData(FGameplayAbilityTargetDataHandle& Data)
+{
+	FGameplayAbilityTargetData* TargetData = Data.Num() == 1 ? Data.Get(0) : nullptr;
+
+	if (!TargetData || TargetData->GetScriptStruct() != FGSGameplayAbilityTargetData_SpreadShot::StaticStruct())
+	{
+		return OnReplicatedTargetDataReceived(Data);
+	}
+
+	if (!RegenerateShot(*static_cast<FGSGameplayAbilityTargetData_SpreadShot*>(TargetData)))
+	{
+		return false;
+	}
+
+	Data = FGSGameplayAbilityTargetData_SpreadShot::ExpandHitResults(Data);
+	return true;
+}
+
+bool AGSGATA_Trace::RegenerateShot(FGSGameplayAbilityTargetData_SpreadShot& Shot)
+{
+	if (!UsesDeterministicSpread() || !OwningAbility || !SourceActor)
+	{
+		return false;
+	}
+
+	const int32 ActivationKey = OwningAbility->GetCurrentActivationInfo().GetActivationPredictionKey().Current;
+
+	if (ActivationKey != ShotActivationKey)
+	{
+		ShotActivationKey = ActivationKey;
+		ExpectedShotIndex = 0;
+	}
+
+	// Shots arrive in order over the reliable TargetData RPC. The index, and so the seed, is the server's count
+	// of the activation's shots, a client can't skip or replay seeds to pick a favorable spread.
+	// The index is replicated in 16 bits.
+	if (static_cast<uint16>(Shot.ShotIndex) != static_cast<uint16>(ExpectedShotIndex))
+	{
+		return false;
+	}
+
+	ExpectedShotIndex++;
+
+	if (FVector::DistSquared(Shot.TraceStart, SourceActor->GetActorLocation()) > FMath::Square(MaxShotOriginError))
+	{
+		return false;
+	}
+
+	// Can't be more accurate than the base spread, allow for the replicated precision
+	const float MinSpread = BaseSpread * GetAimingSpreadModifier();
+	if (Shot.Spread < MinSpread - 0.01f)
+	{
+		Shot.Spread = MinSpread;
+	}
+
+	CurrentShot = Shot;
+
+	TGuardValue<bool> ReplayingShotGuard(bReplayingShot, true);
+	Shot.HitResults = PerformTrace(SourceActor);
+
+	return true;
+}
+
 void AGSGATA_Trace::BeginPlay()
 {
 	Super::BeginPlay();
@@ -186,7 +429,16 @@ void AGSGATA_Trace::LineTraceWithFilter(TArray<FHitResult>& OutHitResults, const
 	check(World);
 
 	TArray<FHitResult> HitResults;
-	World->LineTraceMultiByProfile(HitResults, Start, End, ProfileName, Params);
+	const bool bUseCompiledFilter = CompiledFilter.IsCompiledFor(FilterHandle, ProfileName);
+
+	if (bUseCompiledFilter)
+	{
+		World->LineTraceMultiByChannel(HitResults, Start, End, CompiledFilter.GetTraceChannel(), Params, CompiledFilter.GetResponseParams());
+	}
+	else
+	{
+		World->LineTraceMultiByProfile(HitResults, Start, End, ProfileName, Params);
+	}
 
 	TArray<FHitResult> FilteredHitResults;
 
@@ -197,7 +449,7 @@ void AGSGATA_Trace::LineTraceWithFilter(TArray<FHitResult>& OutHitResults, const
 	{
 		FHitResult& Hit = HitResults[HitIdx];
 
-		if (!Hit.Actor.IsValid() || FilterHandle.FilterPassesForActor(Hit.Actor))
+		if (!Hit.Actor.IsValid() || (bUseCompiledFilter ? CompiledFilter.PassesForActor(Hit.Actor.Get()) : FilterHandle.FilterPassesForActor(Hit.Actor)))
 		{
 			Hit.TraceStart = TraceStart;
 			Hit.TraceEnd = End;
@@ -218,6 +470,17 @@ void AGSGATA_Trace::AimWithPlayerController(const AActor* InSourceActor, FCollis
 		return;
 	}
 
+	const FVector AimDir = ComputeAimDirection(InSourceActor, Params, TraceStart);
+
+	CurrentTargetingSpread = FMath::Min(TargetingSpreadMax, CurrentTargetingSpread + TargetingSpreadIncrement);
+
+	SpreadStream.Initialize(FMath::Rand());
+
+	OutTraceEnd = TraceStart + (ApplySpread(AimDir, GetCurrentSpread()) * MaxRange);
+}
+
+FVector AGSGATA_Trace::ComputeAimDirection(const AActor* InSourceActor, const FCollisionQueryParams& Params, const FVector& TraceStart)
+{
 	// Default values in case of AI Controller
 	FVector ViewStart = TraceStart;
 	FRotator ViewRot = StartLocation.GetTargetingTransform().GetRotation().Rotator();
@@ -241,8 +504,6 @@ void AGSGATA_Trace::AimWithPlayerController(const AActor* InSourceActor, FCollis
 	TArray<FHitResult> HitResults;
 	LineTraceWithFilter(HitResults, InSourceActor->GetWorld(), Filter, ViewStart, ViewEnd, TraceProfile.Name, Params);
 
-	CurrentTargetingSpread = FMath::Min(TargetingSpreadMax, CurrentTargetingSpread + TargetingSpreadIncrement);
-
 	const bool bUseTraceResult = HitResults.Num() > 0 && (FVector::DistSquared(TraceStart, HitResults[0].Location) <= (MaxRange * MaxRange));
 
 	const FVector AdjustedEnd = (bUseTraceResult) ? HitResults[0].Location : ViewEnd;
@@ -269,14 +530,15 @@ void AGSGATA_Trace::AimWithPlayerController(const AActor* InSourceActor, FCollis
 		}
 	}
 
-	const float CurrentSpread = GetCurrentSpread();
+	return AdjustedAimDir;
+}
 
-	const float ConeHalfAngle = FMath::DegreesToRadians(CurrentSpread * 0.5f);
-	const int32 RandomSeed = FMath::Rand();
-	FRandomStream WeaponRandomStream(RandomSeed);
+FVector AGSGATA_Trace::ApplySpread(const FVector& AimDir, float Spread)
+{
+	const float ConeHalfAngle = FMath::DegreesToRadians(Spread * 0.5f);
 
     // Apply aim spread
-	FVector ShootDir = WeaponRandomStream.VRandCone(AdjustedAimDir, ConeHalfAngle, ConeHalfAngle);
+	FVector ShootDir = SpreadStream.VRandCone(AimDir, ConeHalfAngle, ConeHalfAngle);
 
     // Flatten Z direction, if specified
     if (bProjectAim)
@@ -284,7 +546,33 @@ void AGSGATA_Trace::AimWithPlayerController(const AActor* InSourceActor, FCollis
         ShootDir = FVector::PointPlaneProject(ShootDir, FVector::ZeroVector, ProjectionNormal).GetSafeNormal();
     }
 
-	OutTraceEnd = TraceStart + (ShootDir * MaxRange);
+	return ShootDir;
+}
+
+void AGSGATA_Trace::BeginShot(const AActor* InSourceActor, const FCollisionQueryParams& Params, const FVector& TraceStart)
+{
+	if (!OwningAbility) // Server and launching client only
+	{
+		return;
+	}
+
+	const int32 ActivationKey = OwningAbility->GetCurrentActivationInfo().GetActivationPredictionKey().Current;
+
+	if (ActivationKey != ShotActivationKey)
+	{
+		ShotActivationKey = ActivationKey;
+		NextShotIndex = 0;
+	}
+
+	CurrentTargetingSpread = FMath::Min(TargetingSpreadMax, CurrentTargetingSpread + TargetingSpreadIncrement);
+
+	CurrentShot.TraceStart = TraceStart;
+	CurrentShot.AimDirection = ComputeAimDirection(InSourceActor, Params, TraceStart);
+	CurrentShot.Spread = GetCurrentSpread();
+	CurrentShot.ShotIndex = NextShotIndex;
+
+	// Trace with the replicated precision so the server regenerates the same directions
+	CurrentShot.Quantize();
 }
 
 bool AGSGATA_Trace::ClipCameraRayToAbilityRange(FVector CameraLocation, FVector CameraDirection, FVector AbilityCenter, float AbilityRange, FVector& ClippedPosition)
@@ -327,18 +615,28 @@ void AGSGATA_Trace::StopTargeting()
 FGameplayAbilityTargetDataHandle AGSGATA_Trace::MakeTargetData(const TArray<FHitResult>& HitResults) const
 {
 	FGameplayAbilityTargetDataHandle ReturnDataHandle;
+	ReturnDataHandle.Data.Reserve(HitResults.Num());
 
 	for (int32 i = 0; i < HitResults.Num(); i++)
 	{
-		/** Note: These are cleaned up by the FGameplayAbilityTargetDataHandle (via an internal TSharedPtr) */
-		FGameplayAbilityTargetData_SingleTargetHit* ReturnData = new FGameplayAbilityTargetData_SingleTargetHit();
-		ReturnData->HitResult = HitResults[i];
-		ReturnDataHandle.Add(ReturnData);
+		/** Note: These are released to the FGSTargetDataArena by the FGameplayAbilityTargetDataHandle (via an internal TSharedPtr) */
+		FGSTargetDataArena::Add<FGameplayAbilityTargetData_SingleTargetHit>(ReturnDataHandle, HitResults[i]);
 	}
 
 	return ReturnDataHandle;
 }
 
+FGameplayAbilityTargetDataHandle AGSGATA_Trace::MakeSpreadShotTargetData(const TArray<FHitResult>& HitResults) const
+{
+	FGameplayAbilityTargetDataHandle ReturnDataHandle;
+
+	/** Note: This is released to the FGSTargetDataArena by the FGameplayAbilityTargetDataHandle (via an internal TSharedPtr) */
+	FGSGameplayAbilityTargetData_SpreadShot* ReturnData = FGSTargetDataArena::Add<FGSGameplayAbilityTargetData_SpreadShot>(ReturnDataHandle, CurrentShot);
+	ReturnData->HitResults = HitResults;
+
+	return ReturnDataHandle;
+}
+
 TArray<FHitResult> AGSGATA_Trace::PerformTrace(AActor* InSourceActor)
 {
 	bool bTraceComplex = false;
@@ -351,6 +649,11 @@ TArray<FHitResult> AGSGATA_Trace::PerformTrace(AActor* InSourceActor)
 	Params.AddIgnoredActors(ActorsToIgnore);
 	Params.bIgnoreBlocks = bIgnoreBlockingHits;
 
+	if (CompiledFilter.IsCompiledFor(Filter, TraceProfile.Name))
+	{
+		CompiledFilter.AddIgnoredActors(Params);
+	}
+
 	FVector TraceStart = StartLocation.GetTargetingTransform().GetLocation();
 	FVector TraceEnd;
 
@@ -365,22 +668,38 @@ TArray<FHitResult> AGSGATA_Trace::PerformTrace(AActor* InSourceActor)
 	{
 		// Clear any blocking hit results, invalid Actors, or actors out of range
 		//TODO Check for visibility if we add AIPerceptionComponent in the future
-		for (int32 i = PersistentHitResults.Num() - 1; i >= 0; i--)
+		PersistentHitResults.RemoveAll([this, &TraceStart](const FHitResult& HitResult)
 		{
-			FHitResult& HitResult = PersistentHitResults[i];
+			return HitResult.bBlockingHit || !HitResult.Actor.IsValid() || FVector::DistSquared(TraceStart, HitResult.Actor.Get()->GetActorLocation()) > (MaxRange * MaxRange);
+		});
+	}
 
-			if (HitResult.bBlockingHit || !HitResult.Actor.IsValid() || FVector::DistSquared(TraceStart, HitResult.Actor.Get()->GetActorLocation()) > (MaxRange * MaxRange))
-			{
-				PersistentHitResults.RemoveAt(i);
-			}
+	const bool bDeterministicSpread = UsesDeterministicSpread();
+
+	if (bDeterministicSpread)
+	{
+		// Replayed shots were filled by RegenerateShot()
+		if (!bReplayingShot)
+		{
+			BeginShot(InSourceActor, Params, TraceStart);
 		}
+
+		TraceStart = CurrentShot.TraceStart;
+		SpreadStream.Initialize(GetShotSeed(ShotActivationKey, CurrentShot.ShotIndex));
 	}
 
 	TArray<FHitResult> ReturnHitResults;
 
 	for (int32 TraceIndex = 0; TraceIndex < NumberOfTraces; TraceIndex++)
 	{
-		AimWithPlayerController(InSourceActor, Params, TraceStart, TraceEnd);		//Effective on server and launching client only
+		if (bDeterministicSpread)
+		{
+			TraceEnd = TraceStart + (ApplySpread(CurrentShot.AimDirection, CurrentShot.Spread) * MaxRange);
+		}
+		else
+		{
+			AimWithPlayerController(InSourceActor, Params, TraceStart, TraceEnd);		//Effective on server and launching client only
+		}
 
 		// ------------------------------------------------------
 
@@ -409,31 +728,13 @@ TArray<FHitResult> AGSGATA_Trace::PerformTrace(AActor* InSourceActor)
 				// This results in closer actors taking precedence as the further actors will get bumped out of the TArray.
 				if (HitResult.Actor.IsValid() && (!HitResult.bBlockingHit || PersistentHitResults.Num() < 1))
 				{
-					bool bActorAlreadyInPersistentHits = false;
-
 					// Make sure PersistentHitResults doesn't have this hit actor already
-					for (int32 k = 0; k < PersistentHitResults.Num(); k++)
-					{
-						FHitResult& PersistentHitResult = PersistentHitResults[k];
-
-						if (PersistentHitResult.Actor.Get() == HitResult.Actor.Get())
-						{
-							bActorAlreadyInPersistentHits = true;
-							break;
-						}
-					}
-
-					if (bActorAlreadyInPersistentHits)
+					if (PersistentHitResults.Contains(HitResult.Actor.Get()))
 					{
 						continue;
 					}
 
-					if (PersistentHitResults.Num() >= MaxHitResultsPerTrace)
-					{
-						// Treat PersistentHitResults like a queue, remove first element
-						PersistentHitResults.RemoveAt(0);
-					}
-
+					// PersistentHitResults is a queue, adding to it when full evicts the oldest HitResult
 					PersistentHitResults.Add(HitResult);
 				}
 			}
@@ -504,13 +805,18 @@ TArray<FHitResult> AGSGATA_Trace::PerformTrace(AActor* InSourceActor)
 	// Reminder: if bUsePersistentHitResults, Number of Traces = 1
 	if (bUsePersistentHitResults && MaxHitResultsPerTrace > 0)
 	{
+		const FVector PersistentTraceStart = StartLocation.GetTargetingTransform().GetLocation();
+
 		// Handle ReticleActors
-		for (int32 PersistentHitResultIndex = 0; PersistentHitResultIndex < PersistentHitResults.Num(); PersistentHitResultIndex++)
+		PersistentHitResults.ForEach([this, &PersistentTraceStart](FHitResult& HitResult, int32 PersistentHitResultIndex)
 		{
-			FHitResult& HitResult = PersistentHitResults[PersistentHitResultIndex];
-
 			// Update TraceStart because old persistent HitResults will have their original TraceStart and the player could have moved since then
-			HitResult.TraceStart = StartLocation.GetTargetingTransform().GetLocation();
+			HitResult.TraceStart = PersistentTraceStart;
+
+			if (!ReticleActors.IsValidIndex(PersistentHitResultIndex))
+			{
+				return;
+			}
 
 			if (AGameplayAbilityWorldReticle* LocalReticleActor = ReticleActors[PersistentHitResultIndex].Get())
 			{
@@ -530,7 +836,7 @@ TArray<FHitResult> AGSGATA_Trace::PerformTrace(AActor* InSourceActor)
 					LocalReticleActor->SetActorHiddenInGame(true);
 				}
 			}
-		}
+		});
 
 		if (PersistentHitResults.Num() < ReticleActors.Num())
 		{
@@ -545,7 +851,7 @@ TArray<FHitResult> AGSGATA_Trace::PerformTrace(AActor* InSourceActor)
 			}
 		}
 
-		return PersistentHitResults;
+		return PersistentHitResults.ToArray();
 	}
 
 	return ReturnHitResults;
@@ -5,6 +5,7 @@
 #include "AbilitySystemComponent.h"
 #include "Characters/Abilities/GSAbilitySystemComponent.h"
 #include "Characters/Abilities/GSAbilitySystemGlobals.h"
+#include "Characters/Abilities/GSTargetDataArena.h"
 #include "Characters/Abilities/GSTargetType.h"
 #include "Characters/GSCharacterBase.h"
 #include "Characters/Heroes/GSHeroCharacter.h"
@@ -22,6 +23,7 @@ UGSGameplayAbility::UGSGameplayAbility()
 	bActivateOnInput = true;
 	bSourceObjectMustEqualCurrentWeaponToActivate = false;
 	bCannotActivateWhileInteracting = true;
+	bBatchServerTargetData = false;
 
 	// UGSAbilitySystemGlobals hasn't initialized tags yet to set ActivationBlockedTags
 	ActivationBlockedTags.AddTag(FGameplayTag::RequestGameplayTag("State.Dead"));
@@ -47,9 +49,10 @@ FGameplayAbilityTargetDataHandle UGSGameplayAbility::MakeGameplayAbilityTargetDa
 {
 	if (TargetActors.Num() > 0)
 	{
-		FGameplayAbilityTargetData_ActorArray* NewData = new FGameplayAbilityTargetData_ActorArray();
+		FGameplayAbilityTargetDataHandle TargetData;
+		FGameplayAbilityTargetData_ActorArray* NewData = FGSTargetDataArena::Add<FGameplayAbilityTargetData_ActorArray>(TargetData);
 		NewData->TargetActorArray.Append(TargetActors);
-		return FGameplayAbilityTargetDataHandle(NewData);
+		return TargetData;
 	}
 
 	return FGameplayAbilityTargetDataHandle();
@@ -58,11 +61,11 @@ FGameplayAbilityTargetDataHandle UGSGameplayAbility::MakeGameplayAbilityTargetDa
 FGameplayAbilityTargetDataHandle UGSGameplayAbility::MakeGameplayAbilityTargetDataHandleFromHitResults(const TArray<FHitResult> HitResults)
 {
 	FGameplayAbilityTargetDataHandle TargetData;
+	TargetData.Data.Reserve(HitResults.Num());
 
 	for (const FHitResult& HitResult : HitResults)
 	{
-		FGameplayAbilityTargetData_SingleTargetHit* NewData = new FGameplayAbilityTargetData_SingleTargetHit(HitResult);
-		TargetData.Add(NewData);
+		FGSTargetDataArena::Add<FGameplayAbilityTargetData_SingleTargetHit>(TargetData, HitResult);
 	}
 
 	return TargetData;
@@ -145,6 +148,17 @@ bool UGSGameplayAbility::BatchRPCTryActivateAbility(FGameplayAbilitySpecHandle I
 	return false;
 }
 
+void UGSGameplayAbility::CancelAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateCancelAbility)
+{
+	UGSAbilitySystemComponent* GSASC = ActorInfo ? Cast<UGSAbilitySystemComponent>(ActorInfo->AbilitySystemComponent.Get()) : nullptr;
+	if (GSASC)
+	{
+		GSASC->FlushServerTargetDataBatch();
+	}
+
+	Super::CancelAbility(Handle, ActorInfo, ActivationInfo, bReplicateCancelAbility);
+}
+
 void UGSGameplayAbility::ExternalEndAbility()
 {
 	check(CurrentActorInfo);
@@ -171,7 +185,8 @@ bool UGSGameplayAbility::CanActivateAbility(const FGameplayAbilitySpecHandle Han
 	if (bCannotActivateWhileInteracting)
 	{
 		UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get();
-		if (ASC->GetTagCount(InteractingTag) > ASC->GetTagCount(InteractingRemovalTag))
+		UGSAbilitySystemComponent* GSASC = Cast<UGSAbilitySystemComponent>(ASC);
+		if (GSASC ? GSASC->IsInteracting() : ASC->GetTagCount(InteractingTag) > ASC->GetTagCount(InteractingRemovalTag))
 		{
 			return false;
 		}
@@ -0,0 +1,467 @@
+// Copyright 2020 Dan Kestranek.
+
+
+#include "Characters/Abilities/GSInteractionSubsystem.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GASShooter/GASShooter.h"
+#include "Characters/Abilities/GSInteractable.h"
+
+UGSInteractionSubsystem::UGSInteractionSubsystem()
+{
+	CellSize = 500.0f;
+	MaxStaticRadius = 0.0f;
+	ChangeSerial = 0;
+	MovableRemovedSerial = 0;
+}
+
+void UGSInteractionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	UWorld* World = GetWorld();
+
+	if (World)
+	{
+		ActorSpawnedDelegateHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UGSInteractionSubsystem::OnActorSpawned));
+	}
+
+	LevelAddedDelegateHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UGSInteractionSubsystem::OnLevelAddedToWorld);
+}
+
+void UGSInteractionSubsystem::Deinitialize()
+{
+	UWorld* World = GetWorld();
+
+	if (World)
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedDelegateHandle);
+	}
+
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedDelegateHandle);
+
+	Entries.Empty();
+	ComponentToEntry.Empty();
+	Cells.Empty();
+	CellChangeSerials.Empty();
+	MovableEntries.Empty();
+
+	Super::Deinitialize();
+}
+
+void UGSInteractionSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Actors loaded with the map are not spawned
+	for (TActorIterator<AActor> It(&InWorld); It; ++It)
+	{
+		RegisterInteractableActor(*It);
+	}
+}
+
+void UGSInteractionSubsystem::OnActorSpawned(AActor* Actor)
+{
+	RegisterInteractableActor(Actor);
+}
+
+void UGSInteractionSubsystem::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	if (!Level || World != GetWorld())
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		RegisterInteractableActor(Actor);
+	}
+}
+
+void UGSInteractionSubsystem::RegisterInteractableActor(AActor* Actor)
+{
+	if (!IsValid(Actor) || !Actor->Implements<UGSInteractable>())
+	{
+		return;
+	}
+
+	TInlineComponentArray<UPrimitiveComponent*> Components(Actor);
+
+	for (UPrimitiveComponent* Component : Components)
+	{
+		if (IsInteractableComponent(Component))
+		{
+			RegisterInteractable(Component);
+		}
+	}
+}
+
+void UGSInteractionSubsystem::UnregisterInteractableActor(AActor* Actor)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	TInlineComponentArray<UPrimitiveComponent*> Components(Actor);
+
+	for (UPrimitiveComponent* Component : Components)
+	{
+		UnregisterInteractable(Component);
+	}
+}
+
+bool UGSInteractionSubsystem::IsInteractableComponent(const UPrimitiveComponent* Component)
+{
+	// This is so that a big Actor like a computer can have a small interactable button.
+	// Collision may be toggled at runtime so it is checked on query.
+	return Component && Component->GetCollisionResponseToChannel(COLLISION_INTERACTABLE) == ECollisionResponse::ECR_Overlap;
+}
+
+void UGSInteractionSubsystem::RegisterInteractable(UPrimitiveComponent* Component)
+{
+	if (!IsValid(Component) || ComponentToEntry.Contains(Component))
+	{
+		return;
+	}
+
+	AActor* Owner = Component->GetOwner();
+
+	if (!Owner || !Owner->Implements<UGSInteractable>())
+	{
+		return;
+	}
+
+	FEntry Entry;
+	Entry.Component = Component;
+	Entry.Actor = Owner;
+	Entry.Center = Component->Bounds.Origin;
+	Entry.Radius = Component->Bounds.SphereRadius;
+	Entry.Cell = GetCell(Entry.Center);
+	Entry.bMovable = Component->Mobility == EComponentMobility::Movable;
+	Entry.bAvailable = false;
+	Entry.bTrackedAvailability = false;
+	Entry.ChangeSerial = 0;
+
+	const int32 EntryIndex = Entries.Add(Entry);
+	ComponentToEntry.Add(Component, EntryIndex);
+
+	if (Entry.bMovable)
+	{
+		MovableEntries.Add(EntryIndex);
+	}
+	else
+	{
+		AddToCell(EntryIndex);
+	}
+
+	MarkChanged(Entries[EntryIndex]);
+}
+
+void UGSInteractionSubsystem::UnregisterInteractable(UPrimitiveComponent* Component)
+{
+	const int32* EntryIndex = ComponentToEntry.Find(Component);
+
+	if (EntryIndex)
+	{
+		RemoveEntry(*EntryIndex);
+	}
+}
+
+void UGSInteractionSubsystem::SetInteractableAvailable(UPrimitiveComponent* Component, bool bAvailable)
+{
+	const int32* EntryIndex = ComponentToEntry.Find(Component);
+
+	if (!EntryIndex)
+	{
+		RegisterInteractable(Component);
+		EntryIndex = ComponentToEntry.Find(Component);
+
+		if (!EntryIndex)
+		{
+			return;
+		}
+	}
+
+	FEntry& Entry = Entries[*EntryIndex];
+
+	if (Entry.bTrackedAvailability && Entry.bAvailable == bAvailable)
+	{
+		return;
+	}
+
+	Entry.bAvailable = bAvailable;
+	Entry.bTrackedAvailability = true;
+
+	MarkChanged(Entry);
+}
+
+void UGSInteractionSubsystem::UpdateInteractableBounds(UPrimitiveComponent* Component)
+{
+	const int32* EntryIndex = ComponentToEntry.Find(Component);
+
+	if (!EntryIndex || !IsValid(Component))
+	{
+		return;
+	}
+
+	FEntry& Entry = Entries[*EntryIndex];
+
+	if (!Entry.bMovable)
+	{
+		// Old cell changed as well
+		MarkChanged(Entry);
+		RemoveFromCell(*EntryIndex);
+	}
+
+	Entry.Center = Component->Bounds.Origin;
+	Entry.Radius = Component->Bounds.SphereRadius;
+	Entry.Cell = GetCell(Entry.Center);
+
+	if (!Entry.bMovable)
+	{
+		AddToCell(*EntryIndex);
+	}
+
+	MarkChanged(Entry);
+}
+
+FIntVector UGSInteractionSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize),
+		FMath::FloorToInt(Location.Z / CellSize)
+		);
+}
+
+void UGSInteractionSubsystem::AddToCell(int32 EntryIndex)
+{
+	const FEntry& Entry = Entries[EntryIndex];
+
+	Cells.FindOrAdd(Entry.Cell).Add(EntryIndex);
+	MaxStaticRadius = FMath::Max(MaxStaticRadius, Entry.Radius);
+}
+
+void UGSInteractionSubsystem::RemoveFromCell(int32 EntryIndex)
+{
+	const FEntry& Entry = Entries[EntryIndex];
+	TArray<int32>* CellEntries = Cells.Find(Entry.Cell);
+
+	if (CellEntries)
+	{
+		CellEntries->RemoveSwap(EntryIndex);
+
+		if (CellEntries->Num() < 1)
+		{
+			Cells.Remove(Entry.Cell);
+		}
+	}
+}
+
+void UGSInteractionSubsystem::RemoveEntry(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+
+	MarkChanged(Entry);
+
+	if (Entry.bMovable)
+	{
+		MovableRemovedSerial = ChangeSerial;
+		MovableEntries.RemoveSwap(EntryIndex);
+	}
+	else
+	{
+		RemoveFromCell(EntryIndex);
+	}
+
+	ComponentToEntry.Remove(Entry.Component);
+	Entries.RemoveAt(EntryIndex);
+}
+
+void UGSInteractionSubsystem::MarkChanged(FEntry& Entry)
+{
+	++ChangeSerial;
+	Entry.ChangeSerial = ChangeSerial;
+
+	if (!Entry.bMovable)
+	{
+		CellChangeSerials.FindOrAdd(Entry.Cell) = ChangeSerial;
+	}
+}
+
+bool UGSInteractionSubsystem::HasChangedSince(const FVector& Center, float Radius, uint32 Serial) const
+{
+	if (ChangeSerial == Serial)
+	{
+		return false;
+	}
+
+	if (MovableRemovedSerial > Serial)
+	{
+		return true;
+	}
+
+	const float Extent = Radius + MaxStaticRadius;
+	const FIntVector MinCell = GetCell(Center - FVector(Extent));
+	const FIntVector MaxCell = GetCell(Center + FVector(Extent));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				const uint32* CellSerial = CellChangeSerials.Find(FIntVector(X, Y, Z));
+
+				if (CellSerial && *CellSerial > Serial)
+				{
+					return true;
+				}
+			}
+		}
+	}
+
+	for (int32 EntryIndex : MovableEntries)
+	{
+		const FEntry& Entry = Entries[EntryIndex];
+
+		if (Entry.ChangeSerial > Serial && FVector::DistSquared(Center, Entry.Center) <= FMath::Square(Radius + Entry.Radius))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool UGSInteractionSubsystem::IsEntryAvailable(const FEntry& Entry) const
+{
+	if (Entry.bTrackedAvailability)
+	{
+		return Entry.bAvailable;
+	}
+
+	// Interactable doesn't push its state, ask it
+	return IGSInteractable::Execute_IsAvailableForInteraction(Entry.Actor.Get(), Entry.Component.Get());
+}
+
+void UGSInteractionSubsystem::QueryCone(
+	const FVector& RayOrigin,
+	const FVector& RayDirection,
+	const FVector& RangeCenter,
+	float MaxRange,
+	float ConeHalfAngle,
+	const AActor* IgnoreActor,
+	TArray<FGSInteractableCandidate>& OutCandidates
+	)
+{
+	OutCandidates.Reset();
+
+	const float ConeTan = FMath::Tan(FMath::DegreesToRadians(FMath::Clamp(ConeHalfAngle, 0.0f, 89.0f)));
+
+	// Ray may start behind the range center (third person camera), the cone only needs to reach past it
+	const float RayLength = FVector::Dist(RayOrigin, RangeCenter) + MaxRange;
+
+	TArray<int32, TInlineAllocator<8>> StaleEntries;
+
+	auto TestEntry = [&](int32 EntryIndex)
+	{
+		FEntry& Entry = Entries[EntryIndex];
+		UPrimitiveComponent* Component = Entry.Component.Get();
+		AActor* Actor = Entry.Actor.Get();
+
+		if (!Component || !Actor)
+		{
+			StaleEntries.Add(EntryIndex);
+			return;
+		}
+
+		if (Actor == IgnoreActor || !Component->IsQueryCollisionEnabled())
+		{
+			return;
+		}
+
+		if (Entry.bMovable)
+		{
+			Entry.Center = Component->Bounds.Origin;
+			Entry.Radius = Component->Bounds.SphereRadius;
+		}
+
+		// Range
+		if (FVector::DistSquared(RangeCenter, Entry.Center) > FMath::Square(MaxRange + Entry.Radius))
+		{
+			return;
+		}
+
+		// Cone, bounds sphere must intersect the cone widened by the ray distance
+		const float Along = FVector::DotProduct(Entry.Center - RayOrigin, RayDirection);
+
+		if (Along < -Entry.Radius || Along > RayLength + Entry.Radius)
+		{
+			return;
+		}
+
+		const FVector ClosestOnRay = RayOrigin + RayDirection * FMath::Max(Along, 0.0f);
+		const FVector ToCenter = Entry.Center - ClosestOnRay;
+		const float AllowedDistance = Entry.Radius + FMath::Max(Along, 0.0f) * ConeTan;
+
+		if (ToCenter.SizeSquared() > FMath::Square(AllowedDistance))
+		{
+			return;
+		}
+
+		if (!IsEntryAvailable(Entry))
+		{
+			return;
+		}
+
+		FGSInteractableCandidate& Candidate = OutCandidates.AddDefaulted_GetRef();
+		Candidate.Component = Component;
+		Candidate.Actor = Actor;
+		Candidate.Location = Entry.Center - ToCenter.GetClampedToMaxSize(Entry.Radius);
+		Candidate.Distance = Along;
+	};
+
+	// Static entries from the cells overlapping the range sphere
+
+	const float Extent = MaxRange + MaxStaticRadius;
+	const FIntVector MinCell = GetCell(RangeCenter - FVector(Extent));
+	const FIntVector MaxCell = GetCell(RangeCenter + FVector(Extent));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				const TArray<int32>* CellEntries = Cells.Find(FIntVector(X, Y, Z));
+
+				if (CellEntries)
+				{
+					for (int32 EntryIndex : *CellEntries)
+					{
+						TestEntry(EntryIndex);
+					}
+				}
+			}
+		}
+	}
+
+	for (int32 EntryIndex : MovableEntries)
+	{
+		TestEntry(EntryIndex);
+	}
+
+	for (int32 EntryIndex : StaleEntries)
+	{
+		RemoveEntry(EntryIndex);
+	}
+
+	OutCandidates.Sort([](const FGSInteractableCandidate& A, const FGSInteractableCandidate& B)
+	{
+		return A.Distance < B.Distance;
+	});
+}
@@ -0,0 +1,129 @@
+// Copyright 2020 Dan Kestranek.
+
+
+#include "Characters/Abilities/GSTargetDataArena.h"
+#include "Misc/ScopeLock.h"
+
+namespace GSTargetDataArena
+{
+	static const int32 BlockSize = 64 * 1024;
+
+	// Released blocks beyond this are returned to the system allocator
+	static const int32 MaxFreeBlocks = 4;
+}
+
+FGSTargetDataArena& FGSTargetDataArena::Get()
+{
+	// Never destroyed, TargetData can be released during static destruction
+	static FGSTargetDataArena* Arena = new FGSTargetDataArena();
+	return *Arena;
+}
+
+FGSTargetDataArena::FGSTargetDataArena()
+	: CurrentBlock(nullptr)
+	, FreeBlocks(nullptr)
+	, NumFreeBlocks(0)
+	, NumBlocks(0)
+{
+}
+
+void* FGSTargetDataArena::Allocate(SIZE_T Size, uint32 Alignment)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	// Each allocation is preceded by a pointer to its block
+	auto GetOffset = [Alignment](const FBlock* Block)
+	{
+		return Align(Block->Used + static_cast<int32>(sizeof(FBlock*)), static_cast<int32>(Alignment));
+	};
+
+	if (CurrentBlock && GetOffset(CurrentBlock) + Size > GSTargetDataArena::BlockSize)
+	{
+		FBlock* FullBlock = CurrentBlock;
+		CurrentBlock = nullptr;
+
+		// Otherwise released by its last Free()
+		if (FullBlock->NumLive == 0)
+		{
+			ReleaseBlock(FullBlock);
+		}
+	}
+
+	if (!CurrentBlock)
+	{
+		CurrentBlock = AcquireBlock();
+	}
+
+	const int32 Offset = GetOffset(CurrentBlock);
+	check(Offset + Size <= GSTargetDataArena::BlockSize);
+
+	uint8* Memory = reinterpret_cast<uint8*>(CurrentBlock) + Offset;
+	*reinterpret_cast<FBlock**>(Memory - sizeof(FBlock*)) = CurrentBlock;
+
+	CurrentBlock->Used = Offset + static_cast<int32>(Size);
+	CurrentBlock->NumLive++;
+
+	return Memory;
+}
+
+void FGSTargetDataArena::Free(void* Memory)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	FBlock* Block = *reinterpret_cast<FBlock**>(static_cast<uint8*>(Memory) - sizeof(FBlock*));
+
+	check(Block->NumLive > 0);
+	Block->NumLive--;
+
+	if (Block->NumLive > 0)
+	{
+		return;
+	}
+
+	if (Block == CurrentBlock)
+	{
+		// Rewind in place
+		Block->Used = sizeof(FBlock);
+	}
+	else
+	{
+		ReleaseBlock(Block);
+	}
+}
+
+FGSTargetDataArena::FBlock* FGSTargetDataArena::AcquireBlock()
+{
+	FBlock* Block = FreeBlocks;
+
+	if (Block)
+	{
+		FreeBlocks = Block->NextFree;
+		NumFreeBlocks--;
+	}
+	else
+	{
+		Block = static_cast<FBlock*>(FMemory::Malloc(GSTargetDataArena::BlockSize));
+		NumBlocks++;
+	}
+
+	Block->NextFree = nullptr;
+	Block->Used = sizeof(FBlock);
+	Block->NumLive = 0;
+
+	return Block;
+}
+
+void FGSTargetDataArena::ReleaseBlock(FBlock* Block)
+{
+	if (NumFreeBlocks < GSTargetDataArena::MaxFreeBlocks)
+	{
+		Block->NextFree = FreeBlocks;
+		FreeBlocks = Block;
+		NumFreeBlocks++;
+	}
+	else
+	{
+		FMemory::Free(Block);
+		NumBlocks--;
+	}
+}
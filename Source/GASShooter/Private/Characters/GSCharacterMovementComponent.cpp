@@ -2,8 +2,11 @@
 
 #include "Characters/GSCharacterMovementComponent.h"
 #include "AbilitySystemComponent.h"
+#include "Characters/Abilities/GSAbilitySystemComponent.h"
 #include "Characters/Abilities/GSAbilitySystemGlobals.h"
 #include "Characters/GSCharacterBase.h"
+#include "Characters/Heroes/GSHeroCharacter.h"
+#include "EngineUtils.h"
 #include "GameplayTagContainer.h"
 
 /** === Network Prediction Data === */
@@ -15,6 +18,8 @@ void UGSCharacterMovementComponent::FGSSavedMove::Clear()
     SavedRequestToStartWalking = false;
     SavedRequestToStartSprinting = false;
     SavedRequestToStartADS = false;
+    SavedAimYaw = 0;
+    SavedALSState = 0;
 }
 
 uint8 UGSCharacterMovementComponent::FGSSavedMove::GetCompressedFlags() const
@@ -59,6 +64,15 @@ bool UGSCharacterMovementComponent::FGSSavedMove::CanCombineWith(const FSavedMov
         return false;
     }
 
+    // Aim yaw doesn't affect movement simulation, moves with different
+    // aim are still combined and the newest move's yaw is sent.
+
+    // ALS state changes are kept in order with the moves they happened in
+    if (SavedALSState != ((FGSSavedMove*)NewMove.Get())->SavedALSState)
+    {
+        return false;
+    }
+
     return Super::CanCombineWith(NewMove, Character, MaxDelta);
 }
 
@@ -73,6 +87,13 @@ void UGSCharacterMovementComponent::FGSSavedMove::SetMoveFor(ACharacter* Charact
         SavedRequestToStartSprinting = CharacterMovement->RequestToStartSprinting;
         SavedRequestToStartADS = CharacterMovement->RequestToStartADS;
     }
+
+    AGSHeroCharacter* Hero = Cast<AGSHeroCharacter>(Character);
+    if (Hero)
+    {
+        SavedAimYaw = FRotator::CompressAxisToShort(Hero->GetAimingRotation().Yaw);
+        SavedALSState = Hero->PackALSState();
+    }
 }
 
 void UGSCharacterMovementComponent::FGSSavedMove::PrepMoveFor(ACharacter* Character)
@@ -96,56 +117,109 @@ FSavedMovePtr UGSCharacterMovementComponent::FGSNetworkPredictionData_Client::Al
     return FSavedMovePtr(new FGSSavedMove());
 }
 
+UGSCharacterMovementComponent::FGSCharacterNetworkMoveData::FGSCharacterNetworkMoveData()
+    : AimYaw(0)
+    , ALSState(0)
+{
+}
+
+void UGSCharacterMovementComponent::FGSCharacterNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType)
+{
+    Super::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+    AimYaw = static_cast<const FGSSavedMove&>(ClientMove).SavedAimYaw;
+    ALSState = static_cast<const FGSSavedMove&>(ClientMove).SavedALSState;
+}
+
+bool UGSCharacterMovementComponent::FGSCharacterNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType)
+{
+    Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+
+    Ar << AimYaw;
+    Ar.SerializeIntPacked(ALSState);
+
+    return !Ar.IsError();
+}
+
+UGSCharacterMovementComponent::FGSCharacterNetworkMoveDataContainer::FGSCharacterNetworkMoveDataContainer()
+{
+    NewMoveData = &GSMoveData[0];
+    PendingMoveData = &GSMoveData[1];
+    OldMoveData = &GSMoveData[2];
+}
+
 /** === UGSCharacterMovementComponent === */
 
+namespace GSMaxSpeed
+{
+    static const uint8 RunningKey = 0;
+    static const uint8 WalkingKey = 1;
+    static const uint8 SprintingKey = 2;
+    static const uint8 InvalidKey = 0xFF;
+}
+
 UGSCharacterMovementComponent::UGSCharacterMovementComponent()
 {
     SprintSpeedMultiplier = 1.4f;
     ADSSpeedMultiplier = 0.8f;
     KnockedDownSpeedMultiplier = 0.4f;
 
-    KnockedDownTag = FGameplayTag::RequestGameplayTag("State.KnockedDown");
-    InteractingTag = FGameplayTag::RequestGameplayTag("State.Interacting");
-    InteractingRemovalTag = FGameplayTag::RequestGameplayTag("State.InteractingRemoval");
+    HeroOwner = nullptr;
+    CachedGaitSpeed = 0.0f;
+    CachedGaitSpeedKey = GSMaxSpeed::InvalidKey;
+
+    SetNetworkMoveDataContainer(GSNetworkMoveDataContainer);
 }
 
-float UGSCharacterMovementComponent::GetMaxSpeed() const
+void UGSCharacterMovementComponent::SetUpdatedComponent(USceneComponent* NewUpdatedComponent)
 {
-    AGSCharacterBase* Owner = Cast<AGSHeroCharacter>(GetOwner());
+    Super::SetUpdatedComponent(NewUpdatedComponent);
+
+    HeroOwner = Cast<AGSHeroCharacter>(CharacterOwner);
+}
 
-    if (!Owner)
+uint8 UGSCharacterMovementComponent::GetGaitSpeedKey() const
+{
+    if (RequestToStartWalking)
     {
-        UE_LOG(LogTemp, Error, TEXT("%s() No Owner"), *FString(__FUNCTION__));
-        return Super::GetMaxSpeed();
+        return GSMaxSpeed::WalkingKey;
     }
 
-    if (!Owner->IsAlive())
+    if (RequestToStartSprinting)
     {
-        return 0.0f;
+        return GSMaxSpeed::SprintingKey;
     }
 
-    UAbilitySystemComponent* ASC = Owner->GetAbilitySystemComponent();
+    return GSMaxSpeed::RunningKey;
+}
 
-    // Don't move while interacting or being interacted on (revived)
-    if (ASC && ASC->GetTagCount(InteractingTag) > ASC->GetTagCount(InteractingRemovalTag))
+float UGSCharacterMovementComponent::GetMaxSpeed() const
+{
+    // Called several times per move, and for every replayed client move on the server.
+    // Reads only cached state: the owner cast, the ASC character state and the gait speed.
+
+    if (!HeroOwner)
     {
-        return 0.0f;
+        UE_LOG(LogTemp, Error, TEXT("%s() No Owner"), *FString(__FUNCTION__));
+        return Super::GetMaxSpeed();
     }
 
-    if (ASC && ASC->HasMatchingGameplayTag(KnockedDownTag))
+    if (!HeroOwner->IsAlive())
     {
-        return Owner->GetMoveSpeed() * KnockedDownSpeedMultiplier;
+        return 0.0f;
     }
 
-    if (RequestToStartWalking)
+    const UGSAbilitySystemComponent* ASC = HeroOwner->GetGSAbilitySystemComponent();
+
+    // Don't move while interacting or being interacted on (revived)
+    if (ASC && ASC->IsInteracting())
     {
-        return CurrentMovementSettings.GetSpeedForGait(EALSGait::Walking);
+        return 0.0f;
     }
 
-    if (RequestToStartSprinting)
+    if (ASC && ASC->IsKnockedDown())
     {
-        //return Owner->GetMoveSpeed() * SprintSpeedMultiplier;
-        return CurrentMovementSettings.GetSpeedForGait(EALSGait::Sprinting);
+        return HeroOwner->GetMoveSpeed() * KnockedDownSpeedMultiplier;
     }
 
     //if (RequestToStartADS)
@@ -153,8 +227,20 @@ float UGSCharacterMovementComponent::GetMaxSpeed() const
     //  return Owner->GetMoveSpeed() * ADSSpeedMultiplier;
     //}
 
-    //return Owner->GetMoveSpeed();
-    return CurrentMovementSettings.GetSpeedForGait(EALSGait::Running);
+    // Sprinting used to be Owner->GetMoveSpeed() * SprintSpeedMultiplier
+    const uint8 GaitSpeedKey = GetGaitSpeedKey();
+
+    if (GaitSpeedKey != CachedGaitSpeedKey)
+    {
+        const EALSGait Gait = GaitSpeedKey == GSMaxSpeed::WalkingKey
+            ? EALSGait::Walking
+            : (GaitSpeedKey == GSMaxSpeed::SprintingKey ? EALSGait::Sprinting : EALSGait::Running);
+
+        CachedGaitSpeed = CurrentMovementSettings.GetSpeedForGait(Gait);
+        CachedGaitSpeedKey = GaitSpeedKey;
+    }
+
+    return CachedGaitSpeed;
 }
 
 float UGSCharacterMovementComponent::GetMaxAcceleration() const
@@ -215,6 +301,26 @@ FNetworkPredictionData_Client* UGSCharacterMovementComponent::GetPredictionData_
     return ClientPredictionData;
 }
 
+void UGSCharacterMovementComponent::MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel)
+{
+    // Only moves that passed VerifyClientTimeStamp() get here, so stale redundant moves and
+    // out of order packets never roll the aim yaw and ALS states back.
+    // Client replays have no network move data and keep the locally predicted states.
+    const FCharacterNetworkMoveData* MoveData = GetCurrentNetworkMoveData();
+    AGSHeroCharacter* Hero = Cast<AGSHeroCharacter>(CharacterOwner);
+
+    if (Hero && MoveData && CharacterOwner->GetLocalRole() == ROLE_Authority)
+    {
+        // Reconstruct the aim yaw and ALS states from the move data,
+        // this replaces the reliable aiming rotation and ALS state RPCs
+        const FGSCharacterNetworkMoveData* GSMoveData = static_cast<const FGSCharacterNetworkMoveData*>(MoveData);
+        Hero->SetAimingRotation(FRotator(0.0f, FRotator::DecompressAxisFromShort(GSMoveData->AimYaw), 0.0f));
+        Hero->ApplyALSState(GSMoveData->ALSState);
+    }
+
+    Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+}
+
 void UGSCharacterMovementComponent::StartWalking()
 {
     RequestToStartWalking = true;
@@ -294,4 +400,127 @@ void UGSCharacterMovementComponent::SetMovementSettings(FALSMovementSettings New
 {
     // Set the current movement settings from the owner
     CurrentMovementSettings = NewMovementSettings;
+    CachedGaitSpeedKey = GSMaxSpeed::InvalidKey;
+}
+
+#if !UE_BUILD_SHIPPING
+
+// Micro-benchmark of GetMaxSpeed against the previous tag query path, on the heroes of the world
+static void GSMovementBenchmarkMaxSpeed(const TArray<FString>& Args, UWorld* World)
+{
+    const int32 NumCharacters = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 64;
+    const int32 NumIterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 10000;
+
+    TArray<UGSCharacterMovementComponent*> MovementComponents;
+
+    for (TActorIterator<AGSHeroCharacter> It(World); It; ++It)
+    {
+        UGSCharacterMovementComponent* MovementComponent = Cast<UGSCharacterMovementComponent>(It->GetCharacterMovement());
+
+        if (MovementComponent)
+        {
+            MovementComponents.Add(MovementComponent);
+        }
+    }
+
+    if (MovementComponents.Num() < 1)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("GS.Movement.BenchmarkMaxSpeed: No heroes in the world"));
+        return;
+    }
+
+    const FGameplayTag KnockedDownTag = FGameplayTag::RequestGameplayTag("State.KnockedDown");
+    const FGameplayTag InteractingTag = FGameplayTag::RequestGameplayTag("State.Interacting");
+    const FGameplayTag InteractingRemovalTag = FGameplayTag::RequestGameplayTag("State.InteractingRemoval");
+
+    // Previous GetMaxSpeed
+    auto LegacyGetMaxSpeed = [&](const UGSCharacterMovementComponent* MovementComponent)
+    {
+        AGSCharacterBase* Owner = Cast<AGSHeroCharacter>(MovementComponent->GetOwner());
+
+        if (!Owner || !Owner->IsAlive())
+        {
+            return 0.0f;
+        }
+
+        UAbilitySystemComponent* ASC = Owner->GetAbilitySystemComponent();
+
+        if (ASC && ASC->GetTagCount(InteractingTag) > ASC->GetTagCount(InteractingRemovalTag))
+        {
+            return 0.0f;
+        }
+
+        if (ASC && ASC->HasMatchingGameplayTag(KnockedDownTag))
+        {
+            return Owner->GetMoveSpeed() * MovementComponent->KnockedDownSpeedMultiplier;
+        }
+
+        if (MovementComponent->RequestToStartWalking)
+        {
+            return MovementComponent->CurrentMovementSettings.GetSpeedForGait(EALSGait::Walking);
+        }
+
+        if (MovementComponent->RequestToStartSprinting)
+        {
+            return MovementComponent->CurrentMovementSettings.GetSpeedForGait(EALSGait::Sprinting);
+        }
+
+        return MovementComponent->CurrentMovementSettings.GetSpeedForGait(EALSGait::Running);
+    };
+
+    // Fewer heroes than requested are cycled through
+    float Checksum = 0.0f;
+    int32 NumMismatches = 0;
+
+    double StartTime = FPlatformTime::Seconds();
+
+    for (int32 Iteration=0; Iteration<NumIterations; ++Iteration)
+    {
+        for (int32 i=0; i<NumCharacters; ++i)
+        {
+            Checksum += LegacyGetMaxSpeed(MovementComponents[i % MovementComponents.Num()]);
+        }
+    }
+
+    const double LegacyTime = FPlatformTime::Seconds() - StartTime;
+
+    StartTime = FPlatformTime::Seconds();
+
+    for (int32 Iteration=0; Iteration<NumIterations; ++Iteration)
+    {
+        for (int32 i=0; i<NumCharacters; ++i)
+        {
+            Checksum -= MovementComponents[i % MovementComponents.Num()]->GetMaxSpeed();
+        }
+    }
+
+    const double CachedTime = FPlatformTime::Seconds() - StartTime;
+
+    for (UGSCharacterMovementComponent* MovementComponent : MovementComponents)
+    {
+        NumMismatches += FMath::IsNearlyEqual(LegacyGetMaxSpeed(MovementComponent), MovementComponent->GetMaxSpeed()) ? 0 : 1;
+    }
+
+    const double NumCalls = static_cast<double>(NumCharacters) * NumIterations;
+
+    UE_LOG(LogTemp, Log, TEXT("GS.Movement.BenchmarkMaxSpeed: %d characters (%d heroes), %d iterations"),
+        NumCharacters,
+        MovementComponents.Num(),
+        NumIterations
+        );
+
+    UE_LOG(LogTemp, Log, TEXT("  Tag queries: %.2f ns/call, cached: %.2f ns/call, mismatching heroes: %d (checksum %f)"),
+        LegacyTime * 1e9 / NumCalls,
+        CachedTime * 1e9 / NumCalls,
+        NumMismatches,
+        Checksum
+        );
 }
+
+static FAutoConsoleCommandWithWorldAndArgs GSMovementBenchmarkMaxSpeedCommand(
+    TEXT("GS.Movement.BenchmarkMaxSpeed"),
+    TEXT("Compares GetMaxSpeed with the previous tag query path on the heroes of the world. Arguments: [NumCharacters] [NumIterations]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&GSMovementBenchmarkMaxSpeed)
+    );
+
+#endif // !UE_BUILD_SHIPPING
@@ -4,7 +4,6 @@
 #include "Animation/AnimInstance.h"
 #include "Blueprint/WidgetLayoutLibrary.h"
 #include "Camera/CameraComponent.h"
-#include "Components/WidgetComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
@@ -19,15 +18,105 @@
 #include "Characters/Abilities/GSAbilitySystemGlobals.h"
 #include "Characters/Abilities/AttributeSets/GSAmmoAttributeSet.h"
 #include "Characters/Abilities/AttributeSets/GSAttributeSetBase.h"
+#include "Characters/Abilities/GSInteractionSubsystem.h"
 #include "Player/GSPlayerController.h"
 #include "Player/GSPlayerState.h"
-#include "UI/GSFloatingStatusBarWidget.h"
+#include "UI/GSHUD.h"
 
 #include "Character/ALSCharacterMovementComponent.h"
 #include "Character/Animation/ALSCharacterAnimInstance.h"
 
 #include "Weapons/GSWeapon.h"
 
+static TAutoConsoleVariable<float> CVarInputRepDirectionThreshold(
+    TEXT("GS.Movement.InputRepDirectionThreshold"),
+    2.0f,
+    TEXT("Degrees the replicated movement input direction must change before it is sent to simulated proxies")
+);
+
+static TAutoConsoleVariable<float> CVarInputRepAmountThreshold(
+    TEXT("GS.Movement.InputRepAmountThreshold"),
+    0.02f,
+    TEXT("Fraction of the max acceleration the replicated movement input amount must change before it is sent to simulated proxies")
+);
+
+static TAutoConsoleVariable<float> CVarInputRepRotationThreshold(
+    TEXT("GS.Movement.InputRepRotationThreshold"),
+    0.5f,
+    TEXT("Degrees the replicated control rotation pitch or yaw must change before it is sent to simulated proxies")
+);
+
+FGSQuantizedMovementInput::FGSQuantizedMovementInput(const FVector& Acceleration, float MaxAcceleration, const FRotator& ControlRotation)
+    : FGSQuantizedMovementInput()
+{
+    const float AccelerationSize = Acceleration.Size();
+
+    if (AccelerationSize > KINDA_SMALL_NUMBER && MaxAcceleration > 0.0f)
+    {
+        const FVector Direction = Acceleration / AccelerationSize;
+        AccelerationDirX = static_cast<int8>(FMath::RoundToInt(Direction.X * 127.0f));
+        AccelerationDirY = static_cast<int8>(FMath::RoundToInt(Direction.Y * 127.0f));
+        AccelerationDirZ = static_cast<int8>(FMath::RoundToInt(Direction.Z * 127.0f));
+
+        // Round up so any input stays non-zero and proxies keep bHasMovementInput
+        AccelerationAmount = static_cast<uint8>(FMath::Clamp(FMath::CeilToInt(AccelerationSize / MaxAcceleration * 255.0f), 1, 255));
+    }
+
+    ControlPitch = FRotator::CompressAxisToShort(ControlRotation.Pitch);
+    ControlYaw = FRotator::CompressAxisToShort(ControlRotation.Yaw);
+}
+
+FVector FGSQuantizedMovementInput::GetAcceleration(float MaxAcceleration) const
+{
+    if (AccelerationAmount == 0)
+    {
+        return FVector::ZeroVector;
+    }
+
+    const FVector Direction = FVector(AccelerationDirX, AccelerationDirY, AccelerationDirZ).GetSafeNormal();
+    return Direction * (AccelerationAmount / 255.0f * MaxAcceleration);
+}
+
+FRotator FGSQuantizedMovementInput::GetControlRotation() const
+{
+    return FRotator(FRotator::DecompressAxisFromShort(ControlPitch), FRotator::DecompressAxisFromShort(ControlYaw), 0.0f);
+}
+
+bool FGSQuantizedMovementInput::IsSignificantlyDifferent(const FGSQuantizedMovementInput& Other) const
+{
+    if (*this == Other)
+    {
+        return false;
+    }
+
+    if ((AccelerationAmount == 0) != (Other.AccelerationAmount == 0))
+    {
+        return true;
+    }
+
+    if (FMath::Abs(AccelerationAmount - Other.AccelerationAmount) / 255.0f > CVarInputRepAmountThreshold.GetValueOnGameThread())
+    {
+        return true;
+    }
+
+    if (AccelerationAmount != 0)
+    {
+        const FVector Direction = FVector(AccelerationDirX, AccelerationDirY, AccelerationDirZ).GetSafeNormal();
+        const FVector OtherDirection = FVector(Other.AccelerationDirX, Other.AccelerationDirY, Other.AccelerationDirZ).GetSafeNormal();
+        const float MinDirectionDot = FMath::Cos(FMath::DegreesToRadians(CVarInputRepDirectionThreshold.GetValueOnGameThread()));
+
+        if ((Direction | OtherDirection) < MinDirectionDot)
+        {
+            return true;
+        }
+    }
+
+    const FRotator RotationDelta = (GetControlRotation() - Other.GetControlRotation()).GetNormalized();
+    const float RotationThreshold = CVarInputRepRotationThreshold.GetValueOnGameThread();
+
+    return FMath::Abs(RotationDelta.Pitch) > RotationThreshold || FMath::Abs(RotationDelta.Yaw) > RotationThreshold;
+}
+
 AGSHeroCharacter::AGSHeroCharacter(const class FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	PrimaryActorTick.bCanEverTick = true;
@@ -55,19 +144,6 @@ AGSHeroCharacter::AGSHeroCharacter(const class FObjectInitializer& ObjectInitial
     GetMesh()->bCastHiddenShadow = true;
     GetMesh()->bReceivesDecals = false;
 
-    UIFloatingStatusBarComponent = CreateDefaultSubobject<UWidgetComponent>(FName("UIFloatingStatusBarComponent"));
-    UIFloatingStatusBarComponent->SetupAttachment(RootComponent);
-    UIFloatingStatusBarComponent->SetRelativeLocation(FVector(0, 0, 120));
-    UIFloatingStatusBarComponent->SetWidgetSpace(EWidgetSpace::Screen);
-    UIFloatingStatusBarComponent->SetDrawSize(FVector2D(500, 500));
-
-    UIFloatingStatusBarClass = StaticLoadClass(UObject::StaticClass(), nullptr, TEXT("/Game/GASShooter/UI/UI_FloatingStatusBar_Hero.UI_FloatingStatusBar_Hero_C"));
-
-    if (!UIFloatingStatusBarClass)
-    {
-        UE_LOG(LogTemp, Error, TEXT("%s() Failed to find UIFloatingStatusBarClass. If it was moved, please update the reference location in C++."), *FString(__FUNCTION__));
-    }
-
     AutoPossessAI = EAutoPossessAI::PlacedInWorld;
     AIControllerClass = AGSHeroAIController::StaticClass();
 
@@ -94,16 +170,11 @@ void AGSHeroCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Out
     // ALS
 
     //DOREPLIFETIME(AGSHeroCharacter, TargetRagdollLocation);
-    DOREPLIFETIME_CONDITION(AGSHeroCharacter, ReplicatedCurrentAcceleration, COND_SkipOwner);
-    DOREPLIFETIME_CONDITION(AGSHeroCharacter, ReplicatedControlRotation, COND_SkipOwner);
-
-    DOREPLIFETIME(AGSHeroCharacter, DesiredGait);
-    DOREPLIFETIME_CONDITION(AGSHeroCharacter, DesiredStance, COND_SkipOwner);
-    DOREPLIFETIME_CONDITION(AGSHeroCharacter, DesiredRotationMode, COND_SkipOwner);
+    DOREPLIFETIME_CONDITION(AGSHeroCharacter, ReplicatedMovementInput, COND_SkipOwner);
 
-    DOREPLIFETIME_CONDITION(AGSHeroCharacter, RotationMode, COND_SkipOwner);
-    DOREPLIFETIME_CONDITION(AGSHeroCharacter, OverlayState, COND_SkipOwner);
-    DOREPLIFETIME_CONDITION(AGSHeroCharacter, ViewMode, COND_SkipOwner);
+    // Desired gait, stance and rotation mode, rotation mode, view mode and overlay state.
+    // Owners send them with their moves.
+    DOREPLIFETIME_CONDITION(AGSHeroCharacter, ReplicatedALSState, COND_SkipOwner);
 }
 
 // Called to bind functionality to input
@@ -140,6 +211,8 @@ void AGSHeroCharacter::PossessedBy(AController* NewController)
         WeaponChangingDelayReplicationTagChangedDelegateHandle = AbilitySystemComponent->RegisterGameplayTagEvent(WeaponChangingDelayReplicationTag)
             .AddUObject(this, &AGSHeroCharacter::WeaponChangingDelayReplicationTagChanged);
 
+        BindInteractableAvailability();
+
         // Set the AttributeSetBase for convenience attribute functions
         AttributeSetBase = PS->GetAttributeSetBase();
 
@@ -167,21 +240,21 @@ void AGSHeroCharacter::PossessedBy(AController* NewController)
 
         InitializeFloatingStatusBar();
 
-        // If player is host on listen server, the floating status bar would have been created for them from BeginPlay before player possession, hide it
-        if (IsLocallyControlled() && IsPlayerControlled() && UIFloatingStatusBarComponent && UIFloatingStatusBar)
+        // If player is host on listen server, the floating status bar would have been registered for them from BeginPlay before player possession, remove it
+        if (IsLocallyControlled() && IsPlayerControlled())
         {
-            UIFloatingStatusBarComponent->SetVisibility(false, true);
+            AGSHUD* HUD = GetController<APlayerController>()->GetHUD<AGSHUD>();
+
+            if (HUD)
+            {
+                HUD->UnregisterFloatingStatusBar(this);
+            }
         }
     }
 
     SetupStartupPerspective();
 }
 
-UGSFloatingStatusBarWidget* AGSHeroCharacter::GetFloatingStatusBar()
-{
-    return UIFloatingStatusBar;
-}
-
 void AGSHeroCharacter::KnockDown()
 {
     if (!HasAuthority())
@@ -695,6 +768,7 @@ void AGSHeroCharacter::BeginPlay()
     SetRotationMode(DesiredRotationMode);
     SetViewMode(ViewMode);
     SetOverlayState(OverlayState);
+    UpdateReplicatedALSState();
 
     if (Stance == EALSStance::Standing)
     {
@@ -737,6 +811,9 @@ void AGSHeroCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
         AbilitySystemComponent->RemoveLooseGameplayTag(CurrentWeaponTag);
         CurrentWeaponTag = NoWeaponTag;
         AbilitySystemComponent->AddLooseGameplayTag(CurrentWeaponTag);
+
+        // The ASC lives on the PlayerState and outlives this hero
+        AbilitySystemComponent->GetListenerHub().RemoveListener(InteractableTagsListenerHandle);
     }
 
     Super::EndPlay(EndPlayReason);
@@ -896,20 +973,108 @@ FRotator AGSHeroCharacter::GetAimingRotation() const
 
 void AGSHeroCharacter::SetAimingRotation(FRotator NewAimRotation)
 {
-    if (GetLocalRole() < ROLE_Authority)
+    AimingRotation = NewAimRotation;
+}
+
+namespace GSALSState
+{
+    // Bit offsets of the packed ALS state, 4 bits per state and 8 bits for the overlay state
+    static const uint32 DesiredGaitShift = 0;
+    static const uint32 DesiredStanceShift = 4;
+    static const uint32 DesiredRotationModeShift = 8;
+    static const uint32 RotationModeShift = 12;
+    static const uint32 ViewModeShift = 16;
+    static const uint32 OverlayStateShift = 20;
+
+    static const uint32 StateMask = 0xF;
+    static const uint32 OverlayStateMask = 0xFF;
+
+    template<typename EnumType>
+    static uint32 Pack(EnumType Value, uint32 Shift, uint32 Mask)
+    {
+        return (static_cast<uint32>(Value) & Mask) << Shift;
+    }
+
+    // Returns false if the packed value is not a value of the enum (e.g. sent by a modified client)
+    template<typename EnumType>
+    static bool Unpack(uint32 PackedState, uint32 Shift, uint32 Mask, EnumType& OutValue)
+    {
+        const int64 Value = (PackedState >> Shift) & Mask;
+
+        if (!StaticEnum<EnumType>()->IsValidEnumValue(Value))
+        {
+            return false;
+        }
+
+        OutValue = static_cast<EnumType>(Value);
+        return true;
+    }
+}
+
+uint32 AGSHeroCharacter::PackALSState() const
+{
+    return GSALSState::Pack(DesiredGait, GSALSState::DesiredGaitShift, GSALSState::StateMask)
+        | GSALSState::Pack(DesiredStance, GSALSState::DesiredStanceShift, GSALSState::StateMask)
+        | GSALSState::Pack(DesiredRotationMode, GSALSState::DesiredRotationModeShift, GSALSState::StateMask)
+        | GSALSState::Pack(RotationMode, GSALSState::RotationModeShift, GSALSState::StateMask)
+        | GSALSState::Pack(ViewMode, GSALSState::ViewModeShift, GSALSState::StateMask)
+        | GSALSState::Pack(OverlayState, GSALSState::OverlayStateShift, GSALSState::OverlayStateMask);
+}
+
+void AGSHeroCharacter::ApplyALSState(uint32 PackedState)
+{
+    // Most moves carry the current states, don't run the setters and their change events for nothing
+    if (HasActorBegunPlay() && PackedState == PackALSState())
+    {
+        return;
+    }
+
+    EALSGait NewDesiredGait;
+    EALSStance NewDesiredStance;
+    EALSRotationMode NewDesiredRotationMode;
+    EALSRotationMode NewRotationMode;
+    EALSViewMode NewViewMode;
+    EALSOverlayState NewOverlayState;
+
+    const bool bValidState = GSALSState::Unpack(PackedState, GSALSState::DesiredGaitShift, GSALSState::StateMask, NewDesiredGait)
+        && GSALSState::Unpack(PackedState, GSALSState::DesiredStanceShift, GSALSState::StateMask, NewDesiredStance)
+        && GSALSState::Unpack(PackedState, GSALSState::DesiredRotationModeShift, GSALSState::StateMask, NewDesiredRotationMode)
+        && GSALSState::Unpack(PackedState, GSALSState::RotationModeShift, GSALSState::StateMask, NewRotationMode)
+        && GSALSState::Unpack(PackedState, GSALSState::ViewModeShift, GSALSState::StateMask, NewViewMode)
+        && GSALSState::Unpack(PackedState, GSALSState::OverlayStateShift, GSALSState::OverlayStateMask, NewOverlayState);
+
+    if (!bValidState)
+    {
+        return;
+    }
+
+    DesiredGait = NewDesiredGait;
+    DesiredStance = NewDesiredStance;
+    DesiredRotationMode = NewDesiredRotationMode;
+
+    // BeginPlay() applies the initial states once the anim instance is set
+    if (!HasActorBegunPlay())
     {
-        Server_SetAimingRotation(NewAimRotation);
-        AimingRotation = NewAimRotation;
+        RotationMode = NewRotationMode;
+        ViewMode = NewViewMode;
+        OverlayState = NewOverlayState;
     }
     else
     {
-        AimingRotation = NewAimRotation;
+        SetRotationMode(NewRotationMode);
+        SetViewMode(NewViewMode);
+        SetOverlayState(NewOverlayState);
     }
+
+    UpdateReplicatedALSState();
 }
 
-void AGSHeroCharacter::Server_SetAimingRotation_Implementation(FRotator NewAimRotation)
+void AGSHeroCharacter::UpdateReplicatedALSState()
 {
-    SetAimingRotation(NewAimRotation);
+    if (HasAuthority())
+    {
+        ReplicatedALSState = PackALSState();
+    }
 }
 
 void AGSHeroCharacter::BindASCInput()
@@ -925,8 +1090,7 @@ void AGSHeroCharacter::BindASCInput()
 
 void AGSHeroCharacter::InitializeFloatingStatusBar()
 {
-    // Only create once
-    if (UIFloatingStatusBar || !IsValid(AbilitySystemComponent))
+    if (!IsValid(AbilitySystemComponent))
     {
         return;
     }
@@ -943,24 +1107,17 @@ void AGSHeroCharacter::InitializeFloatingStatusBar()
         return;
     }
 
-    // Setup UI for Locally Owned Players only, not AI or the server's copy of the PlayerControllers
+    // Setup UI for Locally Owned Players only, not AI or the server's copy of the PlayerControllers.
+    // Status bars of every hero are drawn by a single overlay on the local HUD.
     AGSPlayerController* PC = Cast<AGSPlayerController>(UGameplayStatics::GetPlayerController(GetWorld(), 0));
     if (PC && PC->IsLocalPlayerController())
     {
-        if (UIFloatingStatusBarClass)
+        AGSHUD* HUD = PC->GetHUD<AGSHUD>();
+
+        // Only register once
+        if (HUD && !HUD->IsFloatingStatusBarRegistered(this))
         {
-            UIFloatingStatusBar = CreateWidget<UGSFloatingStatusBarWidget>(PC, UIFloatingStatusBarClass);
-            if (UIFloatingStatusBar && UIFloatingStatusBarComponent)
-            {
-                UIFloatingStatusBarComponent->SetWidget(UIFloatingStatusBar);
-
-                // Setup the floating status bar
-                UIFloatingStatusBar->SetHealthPercentage(GetHealth() / GetMaxHealth());
-                UIFloatingStatusBar->SetManaPercentage(GetMana() / GetMaxMana());
-                UIFloatingStatusBar->SetShieldPercentage(GetShield() / GetMaxShield());
-                UIFloatingStatusBar->OwningCharacter = this;
-                UIFloatingStatusBar->SetCharacterName(CharacterName);
-            }
+            HUD->RegisterFloatingStatusBar(this, CharacterName);
         }
     }
 }
@@ -984,6 +1141,8 @@ void AGSHeroCharacter::OnRep_PlayerState()
 
         AbilitySystemComponent->AbilityFailedCallbacks.AddUObject(this, &AGSHeroCharacter::OnAbilityActivationFailed);
 
+        BindInteractableAvailability();
+
         // Set the AttributeSetBase for convenience attribute functions
         AttributeSetBase = PS->GetAttributeSetBase();
         
@@ -1534,43 +1693,19 @@ void AGSHeroCharacter::SetGait(const EALSGait NewGait)
 void AGSHeroCharacter::SetDesiredStance(EALSStance NewStance)
 {
     DesiredStance = NewStance;
-    if (GetLocalRole() == ROLE_AutonomousProxy)
-    {
-        Server_SetDesiredStance(NewStance);
-    }
-}
-
-void AGSHeroCharacter::Server_SetDesiredStance_Implementation(EALSStance NewStance)
-{
-    SetDesiredStance(NewStance);
+    UpdateReplicatedALSState();
 }
 
 void AGSHeroCharacter::SetDesiredGait(const EALSGait NewGait)
 {
     DesiredGait = NewGait;
-    if (GetLocalRole() == ROLE_AutonomousProxy)
-    {
-        Server_SetDesiredGait(NewGait);
-    }
-}
-
-void AGSHeroCharacter::Server_SetDesiredGait_Implementation(EALSGait NewGait)
-{
-    SetDesiredGait(NewGait);
+    UpdateReplicatedALSState();
 }
 
 void AGSHeroCharacter::SetDesiredRotationMode(EALSRotationMode NewRotMode)
 {
     DesiredRotationMode = NewRotMode;
-    if (GetLocalRole() == ROLE_AutonomousProxy)
-    {
-        Server_SetDesiredRotationMode(NewRotMode);
-    }
-}
-
-void AGSHeroCharacter::Server_SetDesiredRotationMode_Implementation(EALSRotationMode NewRotMode)
-{
-    SetDesiredRotationMode(NewRotMode);
+    UpdateReplicatedALSState();
 }
 
 void AGSHeroCharacter::SetRotationMode(const EALSRotationMode NewRotationMode)
@@ -1581,18 +1716,10 @@ void AGSHeroCharacter::SetRotationMode(const EALSRotationMode NewRotationMode)
         RotationMode = NewRotationMode;
         OnRotationModeChanged(Prev);
 
-        if (GetLocalRole() == ROLE_AutonomousProxy)
-        {
-            Server_SetRotationMode(NewRotationMode);
-        }
+        UpdateReplicatedALSState();
     }
 }
 
-void AGSHeroCharacter::Server_SetRotationMode_Implementation(EALSRotationMode NewRotationMode)
-{
-    SetRotationMode(NewRotationMode);
-}
-
 void AGSHeroCharacter::SetViewMode(const EALSViewMode NewViewMode)
 {
     if (ViewMode != NewViewMode)
@@ -1601,18 +1728,10 @@ void AGSHeroCharacter::SetViewMode(const EALSViewMode NewViewMode)
         ViewMode = NewViewMode;
         OnViewModeChanged(Prev);
 
-        if (GetLocalRole() == ROLE_AutonomousProxy)
-        {
-            Server_SetViewMode(NewViewMode);
-        }
+        UpdateReplicatedALSState();
     }
 }
 
-void AGSHeroCharacter::Server_SetViewMode_Implementation(EALSViewMode NewViewMode)
-{
-    SetViewMode(NewViewMode);
-}
-
 void AGSHeroCharacter::SetOverlayState(const EALSOverlayState NewState)
 {
     if (OverlayState != NewState)
@@ -1621,19 +1740,10 @@ void AGSHeroCharacter::SetOverlayState(const EALSOverlayState NewState)
         OverlayState = NewState;
         OnOverlayStateChanged(Prev);
 
-        if (GetLocalRole() == ROLE_AutonomousProxy)
-        {
-            Server_SetOverlayState(NewState);
-        }
+        UpdateReplicatedALSState();
     }
 }
 
-
-void AGSHeroCharacter::Server_SetOverlayState_Implementation(EALSOverlayState NewState)
-{
-    SetOverlayState(NewState);
-}
-
 /** ALS - State Changes */
 
 void AGSHeroCharacter::OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode)
@@ -1784,6 +1894,17 @@ void AGSHeroCharacter::SetEssentialValues(float DeltaTime)
         ReplicatedCurrentAcceleration = GetCharacterMovement()->GetCurrentAcceleration();
         ReplicatedControlRotation = GetControlRotation();
         EasedMaxAcceleration = GetCharacterMovement()->GetMaxAcceleration();
+
+        if (HasAuthority())
+        {
+            const FGSQuantizedMovementInput NewMovementInput(ReplicatedCurrentAcceleration, EasedMaxAcceleration, ReplicatedControlRotation);
+
+            // Small changes don't dirty the property, proxies interpolate aiming rotation anyway
+            if (NewMovementInput.IsSignificantlyDifferent(ReplicatedMovementInput))
+            {
+                ReplicatedMovementInput = NewMovementInput;
+            }
+        }
     }
     else
     {
@@ -2073,17 +2194,48 @@ void AGSHeroCharacter::SetMovementModel()
 
 /** ALS - Replication */
 
-void AGSHeroCharacter::OnRep_RotationMode(EALSRotationMode PrevRotMode)
+void AGSHeroCharacter::OnRep_ReplicatedALSState()
+{
+    ApplyALSState(ReplicatedALSState);
+}
+
+void AGSHeroCharacter::OnRep_ReplicatedMovementInput()
 {
-    OnRotationModeChanged(PrevRotMode);
+    ReplicatedCurrentAcceleration = ReplicatedMovementInput.GetAcceleration(GetCharacterMovement()->GetMaxAcceleration());
+    ReplicatedControlRotation = ReplicatedMovementInput.GetControlRotation();
 }
 
-void AGSHeroCharacter::OnRep_ViewMode(EALSViewMode PrevViewMode)
+void AGSHeroCharacter::InteractableTagsChanged(const FGameplayTag CallbackTag, int32 NewCount)
 {
-    OnViewModeChanged(PrevViewMode);
+    UpdateInteractableAvailability();
 }
 
-void AGSHeroCharacter::OnRep_OverlayState(EALSOverlayState PrevOverlayState)
+void AGSHeroCharacter::BindInteractableAvailability()
 {
-    OnOverlayStateChanged(PrevOverlayState);
+    if (!IsValid(AbilitySystemComponent) || InteractableTagsListenerHandle.IsValid())
+    {
+        return;
+    }
+
+    FGameplayTagContainer InteractableTags;
+    InteractableTags.AddTag(KnockedDownTag);
+    InteractableTags.AddTag(InteractingTag);
+
+    InteractableTagsListenerHandle = AbilitySystemComponent->GetListenerHub().ListenForGameplayTags(
+        InteractableTags,
+        FGSGameplayTagListenerDelegate::CreateUObject(this, &AGSHeroCharacter::InteractableTagsChanged)
+        );
+
+    UpdateInteractableAvailability();
+}
+
+void AGSHeroCharacter::UpdateInteractableAvailability()
+{
+    UGSInteractionSubsystem* InteractionSubsystem = GetWorld()->GetSubsystem<UGSInteractionSubsystem>();
+    UPrimitiveComponent* InteractionComponent = GetMainMesh();
+
+    if (InteractionSubsystem && InteractionComponent)
+    {
+        InteractionSubsystem->SetInteractableAvailable(InteractionComponent, Execute_IsAvailableForInteraction(this, InteractionComponent));
+    }
 }
@@ -1,6 +1,229 @@
 // Copyright 2020 Nuraga Wiswakarma.
 
 #include "GSMathLibrary.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+#define GS_MATH_BATCH_SIMD PLATFORM_ENABLE_VECTORINTRINSICS
+
+void FGSCapsuleSoA::Reserve(int32 Num)
+{
+    X.Reserve(Num);
+    Y.Reserve(Num);
+    Z.Reserve(Num);
+    Radius.Reserve(Num);
+    HalfHeight.Reserve(Num);
+}
+
+void FGSCapsuleSoA::Reset()
+{
+    X.Reset();
+    Y.Reset();
+    Z.Reset();
+    Radius.Reset();
+    HalfHeight.Reset();
+}
+
+void FGSCapsuleSoA::Add(const FVector& Location, float InRadius, float InHalfHeight)
+{
+    X.Add(Location.X);
+    Y.Add(Location.Y);
+    Z.Add(Location.Z);
+    Radius.Add(InRadius);
+    HalfHeight.Add(InHalfHeight);
+}
+
+void FGSSweptSphereSoA::Reserve(int32 Num)
+{
+    StartX.Reserve(Num);
+    StartY.Reserve(Num);
+    StartZ.Reserve(Num);
+    EndX.Reserve(Num);
+    EndY.Reserve(Num);
+    EndZ.Reserve(Num);
+    Radius.Reserve(Num);
+}
+
+void FGSSweptSphereSoA::Reset()
+{
+    StartX.Reset();
+    StartY.Reset();
+    StartZ.Reset();
+    EndX.Reset();
+    EndY.Reset();
+    EndZ.Reset();
+    Radius.Reset();
+}
+
+void FGSSweptSphereSoA::Add(const FVector& Start, const FVector& End, float InRadius)
+{
+    StartX.Add(Start.X);
+    StartY.Add(Start.Y);
+    StartZ.Add(Start.Z);
+    EndX.Add(End.X);
+    EndY.Add(End.Y);
+    EndZ.Add(End.Z);
+    Radius.Add(InRadius);
+}
+
+void FGSSegmentSoA::Reserve(int32 Num)
+{
+    StartX.Reserve(Num);
+    StartY.Reserve(Num);
+    StartZ.Reserve(Num);
+    EndX.Reserve(Num);
+    EndY.Reserve(Num);
+    EndZ.Reserve(Num);
+}
+
+void FGSSegmentSoA::Reset()
+{
+    StartX.Reset();
+    StartY.Reset();
+    StartZ.Reset();
+    EndX.Reset();
+    EndY.Reset();
+    EndZ.Reset();
+}
+
+void FGSSegmentSoA::Add(const FVector& Start, const FVector& End)
+{
+    StartX.Add(Start.X);
+    StartY.Add(Start.Y);
+    StartZ.Add(Start.Z);
+    EndX.Add(End.X);
+    EndY.Add(End.Y);
+    EndZ.Add(End.Z);
+}
+
+#if GS_MATH_BATCH_SIMD
+
+namespace GSMathBatch
+{
+    // Segment shared by every lane of a batch query
+    struct FSharedSegment
+    {
+        VectorRegister PX, PY, PZ;
+        VectorRegister DX, DY, DZ;
+        VectorRegister LengthSq;
+        bool bDegenerate;
+
+        FSharedSegment(const FVector& Start, const FVector& End)
+        {
+            const FVector Dir = End - Start;
+
+            PX = VectorSetFloat1(Start.X);
+            PY = VectorSetFloat1(Start.Y);
+            PZ = VectorSetFloat1(Start.Z);
+            DX = VectorSetFloat1(Dir.X);
+            DY = VectorSetFloat1(Dir.Y);
+            DZ = VectorSetFloat1(Dir.Z);
+            LengthSq = VectorSetFloat1(Dir.SizeSquared());
+            bDegenerate = Dir.SizeSquared() <= SMALL_NUMBER;
+        }
+    };
+
+    FORCEINLINE VectorRegister Dot3(
+        const VectorRegister& AX,
+        const VectorRegister& AY,
+        const VectorRegister& AZ,
+        const VectorRegister& BX,
+        const VectorRegister& BY,
+        const VectorRegister& BZ
+        )
+    {
+        return VectorMultiplyAdd(AX, BX, VectorMultiplyAdd(AY, BY, VectorMultiply(AZ, BZ)));
+    }
+
+    FORCEINLINE VectorRegister Clamp01(const VectorRegister& V)
+    {
+        return VectorMin(VectorMax(V, VectorZero()), VectorOne());
+    }
+
+    // Delta between the closest points of four lane segments (P + S*D) and
+    // the shared segment, lane point minus shared point. Clamped parameter
+    // solve from Ericson, Real-Time Collision Detection 5.1.9.
+    FORCEINLINE void ClosestPointsDelta(
+        const VectorRegister& PX,
+        const VectorRegister& PY,
+        const VectorRegister& PZ,
+        const VectorRegister& DX,
+        const VectorRegister& DY,
+        const VectorRegister& DZ,
+        const FSharedSegment& Shared,
+        VectorRegister& OutX,
+        VectorRegister& OutY,
+        VectorRegister& OutZ
+        )
+    {
+        const VectorRegister Zero = VectorZero();
+        const VectorRegister One = VectorOne();
+        const VectorRegister Epsilon = VectorSetFloat1(SMALL_NUMBER);
+
+        const VectorRegister RX = VectorSubtract(PX, Shared.PX);
+        const VectorRegister RY = VectorSubtract(PY, Shared.PY);
+        const VectorRegister RZ = VectorSubtract(PZ, Shared.PZ);
+
+        const VectorRegister A = Dot3(DX, DY, DZ, DX, DY, DZ);
+        const VectorRegister C = Dot3(DX, DY, DZ, RX, RY, RZ);
+
+        // Degenerate lane segments divide by one and are replaced below
+        const VectorRegister ValidA = VectorCompareGT(A, Epsilon);
+        const VectorRegister SafeA = VectorSelect(ValidA, A, One);
+
+        VectorRegister S;
+        VectorRegister T;
+
+        if (Shared.bDegenerate)
+        {
+            S = VectorSelect(ValidA, Clamp01(VectorDivide(VectorNegate(C), SafeA)), Zero);
+            T = Zero;
+        }
+        else
+        {
+            const VectorRegister E = Shared.LengthSq;
+            const VectorRegister B = Dot3(DX, DY, DZ, Shared.DX, Shared.DY, Shared.DZ);
+            const VectorRegister F = Dot3(Shared.DX, Shared.DY, Shared.DZ, RX, RY, RZ);
+
+            // Parallel segments pick S = 0
+            const VectorRegister Denom = VectorSubtract(VectorMultiply(A, E), VectorMultiply(B, B));
+            const VectorRegister ValidDenom = VectorCompareGT(Denom, Epsilon);
+            const VectorRegister SafeDenom = VectorSelect(ValidDenom, Denom, One);
+
+            S = VectorSubtract(VectorMultiply(B, F), VectorMultiply(C, E));
+            S = VectorSelect(ValidDenom, Clamp01(VectorDivide(S, SafeDenom)), Zero);
+            T = VectorDivide(VectorMultiplyAdd(B, S, F), E);
+
+            // T outside of the shared segment, clamp it and recompute S
+            const VectorRegister SBelow = Clamp01(VectorDivide(VectorNegate(C), SafeA));
+            const VectorRegister SAbove = Clamp01(VectorDivide(VectorSubtract(B, C), SafeA));
+
+            S = VectorSelect(VectorCompareLT(T, Zero), SBelow, VectorSelect(VectorCompareGT(T, One), SAbove, S));
+            T = Clamp01(T);
+
+            // Degenerate lane segments are points
+            S = VectorSelect(ValidA, S, Zero);
+            T = VectorSelect(ValidA, T, Clamp01(VectorDivide(F, E)));
+        }
+
+        OutX = VectorSubtract(VectorMultiplyAdd(DX, S, RX), VectorMultiply(Shared.DX, T));
+        OutY = VectorSubtract(VectorMultiplyAdd(DY, S, RY), VectorMultiply(Shared.DY, T));
+        OutZ = VectorSubtract(VectorMultiplyAdd(DZ, S, RZ), VectorMultiply(Shared.DZ, T));
+    }
+
+    FORCEINLINE void AddHitIndices(int32 HitMask, int32 BaseIndex, TArray<int32>& OutHitIndices)
+    {
+        for (int32 Lane=0; Lane<4; ++Lane)
+        {
+            if (HitMask & (1 << Lane))
+            {
+                OutHitIndices.Add(BaseIndex+Lane);
+            }
+        }
+    }
+}
+
+#endif // GS_MATH_BATCH_SIMD
 
 bool UGSMathLibrary::IsObservedObjectMovingRight_HeadingOnly(
     FVector ObserverLocation,
@@ -212,8 +435,8 @@ void UGSMathLibrary::ClosestPointsBetweenSegments(
 {
     FMath::SegmentDistToSegmentSafe(
         SegmentAStart,
-        SegmentBStart,
         SegmentAEnd,
+        SegmentBStart,
         SegmentBEnd,
         OutPointA,
         OutPointB
@@ -236,8 +459,8 @@ bool UGSMathLibrary::CapsuleAndSweepSphereIntersection(
 
     FMath::SegmentDistToSegmentSafe(
         CapsuleSegment0,
-        SphereStart,
         CapsuleSegment1,
+        SphereStart,
         SphereEnd,
         OutPointA,
         OutPointB
@@ -262,8 +485,8 @@ bool UGSMathLibrary::SweepCapsuleAndSphereIntersection(
 {
     FMath::SegmentDistToSegmentSafe(
         CapsuleStart,
-        SphereStart,
         CapsuleEnd,
+        SphereStart,
         SphereEnd,
         OutPointA,
         OutPointB
@@ -275,3 +498,334 @@ bool UGSMathLibrary::SweepCapsuleAndSphereIntersection(
 
     return PointDelta.SizeSquared2D() <= RadiusSq && PointDelta.Z <= Height;
 }
+
+void UGSMathLibrary::SegmentsDistSqToSegment(
+    const FGSSegmentSoA& Segments,
+    const FVector& Start,
+    const FVector& End,
+    TArray<float>& OutDistSq
+    )
+{
+    const int32 Num = Segments.Num();
+    int32 i = 0;
+
+    OutDistSq.SetNumUninitialized(Num);
+
+#if GS_MATH_BATCH_SIMD
+    const GSMathBatch::FSharedSegment Shared(Start, End);
+
+    for (; i+4<=Num; i+=4)
+    {
+        const VectorRegister PX = VectorLoad(Segments.StartX.GetData()+i);
+        const VectorRegister PY = VectorLoad(Segments.StartY.GetData()+i);
+        const VectorRegister PZ = VectorLoad(Segments.StartZ.GetData()+i);
+        const VectorRegister DX = VectorSubtract(VectorLoad(Segments.EndX.GetData()+i), PX);
+        const VectorRegister DY = VectorSubtract(VectorLoad(Segments.EndY.GetData()+i), PY);
+        const VectorRegister DZ = VectorSubtract(VectorLoad(Segments.EndZ.GetData()+i), PZ);
+
+        VectorRegister DeltaX, DeltaY, DeltaZ;
+        GSMathBatch::ClosestPointsDelta(PX, PY, PZ, DX, DY, DZ, Shared, DeltaX, DeltaY, DeltaZ);
+
+        VectorStore(GSMathBatch::Dot3(DeltaX, DeltaY, DeltaZ, DeltaX, DeltaY, DeltaZ), OutDistSq.GetData()+i);
+    }
+#endif
+
+    for (; i<Num; ++i)
+    {
+        FVector PointA;
+        FVector PointB;
+
+        ClosestPointsBetweenSegments(
+            FVector(Segments.StartX[i], Segments.StartY[i], Segments.StartZ[i]),
+            FVector(Segments.EndX[i], Segments.EndY[i], Segments.EndZ[i]),
+            Start,
+            End,
+            PointA,
+            PointB
+            );
+
+        OutDistSq[i] = FVector::DistSquared(PointA, PointB);
+    }
+}
+
+void UGSMathLibrary::SweepSphereAgainstCapsules(
+    const FGSCapsuleSoA& Capsules,
+    const FVector& SphereStart,
+    const FVector& SphereEnd,
+    float SphereRadius,
+    TArray<int32>& OutHitIndices
+    )
+{
+    const int32 Num = Capsules.Num();
+    int32 i = 0;
+
+#if GS_MATH_BATCH_SIMD
+    const GSMathBatch::FSharedSegment Shared(SphereStart, SphereEnd);
+    const VectorRegister SphereRadiusV = VectorSetFloat1(SphereRadius);
+    const VectorRegister Zero = VectorZero();
+    const VectorRegister Two = VectorSetFloat1(2.f);
+
+    for (; i+4<=Num; i+=4)
+    {
+        const VectorRegister HalfHeight = VectorLoad(Capsules.HalfHeight.GetData()+i);
+
+        // Capsule segment from bottom to top
+        const VectorRegister PX = VectorLoad(Capsules.X.GetData()+i);
+        const VectorRegister PY = VectorLoad(Capsules.Y.GetData()+i);
+        const VectorRegister PZ = VectorSubtract(VectorLoad(Capsules.Z.GetData()+i), HalfHeight);
+        const VectorRegister DZ = VectorMultiply(HalfHeight, Two);
+
+        VectorRegister DeltaX, DeltaY, DeltaZ;
+        GSMathBatch::ClosestPointsDelta(PX, PY, PZ, Zero, Zero, DZ, Shared, DeltaX, DeltaY, DeltaZ);
+
+        const VectorRegister DistSq = GSMathBatch::Dot3(DeltaX, DeltaY, DeltaZ, DeltaX, DeltaY, DeltaZ);
+        const VectorRegister RadiusSum = VectorAdd(VectorLoad(Capsules.Radius.GetData()+i), SphereRadiusV);
+        const VectorRegister Hit = VectorCompareLT(DistSq, VectorMultiply(RadiusSum, RadiusSum));
+
+        GSMathBatch::AddHitIndices(VectorMaskBits(Hit), i, OutHitIndices);
+    }
+#endif
+
+    for (; i<Num; ++i)
+    {
+        FVector PointA;
+        FVector PointB;
+
+        const bool bHit = CapsuleAndSweepSphereIntersection(
+            FVector(Capsules.X[i], Capsules.Y[i], Capsules.Z[i]),
+            Capsules.Radius[i],
+            Capsules.HalfHeight[i],
+            SphereStart,
+            SphereEnd,
+            SphereRadius,
+            PointA,
+            PointB
+            );
+
+        if (bHit)
+        {
+            OutHitIndices.Add(i);
+        }
+    }
+}
+
+void UGSMathLibrary::SweepSpheresAgainstCapsule(
+    const FGSSweptSphereSoA& Spheres,
+    const FVector& CapsuleStart,
+    const FVector& CapsuleEnd,
+    float CapsuleRadius,
+    float CapsuleHalfHeight,
+    TArray<int32>& OutHitIndices
+    )
+{
+    const int32 Num = Spheres.Num();
+    int32 i = 0;
+
+#if GS_MATH_BATCH_SIMD
+    const GSMathBatch::FSharedSegment Shared(CapsuleStart, CapsuleEnd);
+    const VectorRegister CapsuleRadiusV = VectorSetFloat1(CapsuleRadius);
+    const VectorRegister CapsuleHeightV = VectorSetFloat1(CapsuleHalfHeight+CapsuleRadius);
+
+    for (; i+4<=Num; i+=4)
+    {
+        const VectorRegister PX = VectorLoad(Spheres.StartX.GetData()+i);
+        const VectorRegister PY = VectorLoad(Spheres.StartY.GetData()+i);
+        const VectorRegister PZ = VectorLoad(Spheres.StartZ.GetData()+i);
+        const VectorRegister DX = VectorSubtract(VectorLoad(Spheres.EndX.GetData()+i), PX);
+        const VectorRegister DY = VectorSubtract(VectorLoad(Spheres.EndY.GetData()+i), PY);
+        const VectorRegister DZ = VectorSubtract(VectorLoad(Spheres.EndZ.GetData()+i), PZ);
+
+        // Sphere point minus capsule point, same as the scalar point delta
+        VectorRegister DeltaX, DeltaY, DeltaZ;
+        GSMathBatch::ClosestPointsDelta(PX, PY, PZ, DX, DY, DZ, Shared, DeltaX, DeltaY, DeltaZ);
+
+        const VectorRegister SphereRadius = VectorLoad(Spheres.Radius.GetData()+i);
+        const VectorRegister RadiusSum = VectorAdd(CapsuleRadiusV, SphereRadius);
+        const VectorRegister DistSq2D = VectorMultiplyAdd(DeltaX, DeltaX, VectorMultiply(DeltaY, DeltaY));
+        const VectorRegister Height = VectorAdd(CapsuleHeightV, SphereRadius);
+
+        const VectorRegister Hit = VectorBitwiseAnd(
+            VectorCompareLE(DistSq2D, VectorMultiply(RadiusSum, RadiusSum)),
+            VectorCompareLE(DeltaZ, Height)
+            );
+
+        GSMathBatch::AddHitIndices(VectorMaskBits(Hit), i, OutHitIndices);
+    }
+#endif
+
+    for (; i<Num; ++i)
+    {
+        FVector PointA;
+        FVector PointB;
+
+        const bool bHit = SweepCapsuleAndSphereIntersection(
+            CapsuleStart,
+            CapsuleEnd,
+            CapsuleRadius,
+            CapsuleHalfHeight,
+            FVector(Spheres.StartX[i], Spheres.StartY[i], Spheres.StartZ[i]),
+            FVector(Spheres.EndX[i], Spheres.EndY[i], Spheres.EndZ[i]),
+            Spheres.Radius[i],
+            PointA,
+            PointB
+            );
+
+        if (bHit)
+        {
+            OutHitIndices.Add(i);
+        }
+    }
+}
+
+#if !UE_BUILD_SHIPPING
+
+// Micro-benchmark of the batch intersection functions against the scalar functions
+static void GSMathBenchmarkBatchIntersection(const TArray<FString>& Args)
+{
+    const int32 NumElements = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1024;
+    const int32 NumIterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 1000;
+
+    FRandomStream Random(NumElements);
+    const FBox Bounds(FVector(-5000.f), FVector(5000.f));
+
+    FGSCapsuleSoA Capsules;
+    FGSSweptSphereSoA Spheres;
+
+    Capsules.Reserve(NumElements);
+    Spheres.Reserve(NumElements);
+
+    for (int32 i=0; i<NumElements; ++i)
+    {
+        Capsules.Add(Random.RandPointInBox(Bounds), Random.FRandRange(30.f, 50.f), Random.FRandRange(60.f, 100.f));
+
+        const FVector SphereStart = Random.RandPointInBox(Bounds);
+        Spheres.Add(SphereStart, SphereStart + Random.GetUnitVector() * 2000.f, Random.FRandRange(5.f, 20.f));
+    }
+
+    const FVector SphereStart = Random.RandPointInBox(Bounds);
+    const FVector SphereEnd = SphereStart + Random.GetUnitVector() * 5000.f;
+    const float SphereRadius = 500.f;
+
+    const FVector CapsuleStart = Random.RandPointInBox(Bounds);
+    const FVector CapsuleEnd = CapsuleStart + Random.GetUnitVector() * 1000.f;
+    const float CapsuleRadius = 500.f;
+    const float CapsuleHalfHeight = 500.f;
+
+    TArray<int32> ScalarHits;
+    TArray<int32> BatchHits;
+    FVector PointA;
+    FVector PointB;
+
+    auto CountMismatches = [NumElements](const TArray<int32>& A, const TArray<int32>& B)
+    {
+        TBitArray<> Mask(false, NumElements);
+        int32 Mismatches = 0;
+
+        for (int32 Index : A)
+        {
+            Mask[Index] = true;
+        }
+
+        for (int32 Index : B)
+        {
+            Mismatches += Mask[Index] ? 0 : 1;
+            Mask[Index] = false;
+        }
+
+        for (TConstSetBitIterator<> It(Mask); It; ++It)
+        {
+            ++Mismatches;
+        }
+
+        return Mismatches;
+    };
+
+    // One swept sphere against every capsule
+
+    double StartTime = FPlatformTime::Seconds();
+
+    for (int32 Iteration=0; Iteration<NumIterations; ++Iteration)
+    {
+        ScalarHits.Reset();
+
+        for (int32 i=0; i<NumElements; ++i)
+        {
+            const FVector Location(Capsules.X[i], Capsules.Y[i], Capsules.Z[i]);
+
+            if (UGSMathLibrary::CapsuleAndSweepSphereIntersection(Location, Capsules.Radius[i], Capsules.HalfHeight[i], SphereStart, SphereEnd, SphereRadius, PointA, PointB))
+            {
+                ScalarHits.Add(i);
+            }
+        }
+    }
+
+    const double ScalarCapsulesTime = FPlatformTime::Seconds() - StartTime;
+    StartTime = FPlatformTime::Seconds();
+
+    for (int32 Iteration=0; Iteration<NumIterations; ++Iteration)
+    {
+        BatchHits.Reset();
+        UGSMathLibrary::SweepSphereAgainstCapsules(Capsules, SphereStart, SphereEnd, SphereRadius, BatchHits);
+    }
+
+    const double BatchCapsulesTime = FPlatformTime::Seconds() - StartTime;
+
+    UE_LOG(LogTemp, Log, TEXT("SweepSphereAgainstCapsules: %d capsules x %d iterations, scalar %.3f ms, batch %.3f ms (%.2fx), %d hits, %d mismatches"),
+        NumElements,
+        NumIterations,
+        ScalarCapsulesTime * 1000.0,
+        BatchCapsulesTime * 1000.0,
+        ScalarCapsulesTime / FMath::Max(BatchCapsulesTime, SMALL_NUMBER),
+        ScalarHits.Num(),
+        CountMismatches(ScalarHits, BatchHits)
+        );
+
+    // Every swept sphere against one swept capsule
+
+    StartTime = FPlatformTime::Seconds();
+
+    for (int32 Iteration=0; Iteration<NumIterations; ++Iteration)
+    {
+        ScalarHits.Reset();
+
+        for (int32 i=0; i<NumElements; ++i)
+        {
+            const FVector Start(Spheres.StartX[i], Spheres.StartY[i], Spheres.StartZ[i]);
+            const FVector End(Spheres.EndX[i], Spheres.EndY[i], Spheres.EndZ[i]);
+
+            if (UGSMathLibrary::SweepCapsuleAndSphereIntersection(CapsuleStart, CapsuleEnd, CapsuleRadius, CapsuleHalfHeight, Start, End, Spheres.Radius[i], PointA, PointB))
+            {
+                ScalarHits.Add(i);
+            }
+        }
+    }
+
+    const double ScalarSpheresTime = FPlatformTime::Seconds() - StartTime;
+    StartTime = FPlatformTime::Seconds();
+
+    for (int32 Iteration=0; Iteration<NumIterations; ++Iteration)
+    {
+        BatchHits.Reset();
+        UGSMathLibrary::SweepSpheresAgainstCapsule(Spheres, CapsuleStart, CapsuleEnd, CapsuleRadius, CapsuleHalfHeight, BatchHits);
+    }
+
+    const double BatchSpheresTime = FPlatformTime::Seconds() - StartTime;
+
+    UE_LOG(LogTemp, Log, TEXT("SweepSpheresAgainstCapsule: %d spheres x %d iterations, scalar %.3f ms, batch %.3f ms (%.2fx), %d hits, %d mismatches"),
+        NumElements,
+        NumIterations,
+        ScalarSpheresTime * 1000.0,
+        BatchSpheresTime * 1000.0,
+        ScalarSpheresTime / FMath::Max(BatchSpheresTime, SMALL_NUMBER),
+        ScalarHits.Num(),
+        CountMismatches(ScalarHits, BatchHits)
+        );
+}
+
+static FAutoConsoleCommand GSMathBenchmarkBatchIntersectionCommand(
+    TEXT("GS.Math.BenchmarkBatchIntersection"),
+    TEXT("Compares scalar and batch capsule/sphere intersection throughput. Arguments: [NumElements] [NumIterations]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&GSMathBenchmarkBatchIntersection)
+    );
+
+#endif // !UE_BUILD_SHIPPING
@@ -8,6 +8,7 @@
 #include "Characters/Heroes/GSHeroCharacter.h"
 #include "Player/GSPlayerState.h"
 #include "UI/GSHUD.h"
+#include "UI/GSHUDViewModel.h"
 #include "UI/GSHUDWidget.h"
 #include "Weapons/GSWeapon.h"
 #include "Weapons/GSUTProjectile.h"
@@ -47,6 +48,16 @@ void AGSPlayerController::BeginPlay()
 	}
 }
 
+void AGSPlayerController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (HUDViewModel)
+    {
+        HUDViewModel->Unbind();
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
 //void AGSPlayerController::OnWindowFocusChanged(bool bIsFocused)
 //{
 //    if (bIsFocused)
@@ -89,6 +100,12 @@ void AGSPlayerController::Tick(float DeltaTime)
     {
         UpdatePawnControlProjection(DeltaTime);
     }
+
+    // Push attribute changes of this frame to the HUD
+    if (HUDViewModel && HUDViewModel->IsDirty())
+    {
+        HUDViewModel->Flush(UIHUDWidget);
+    }
 }
 
 void AGSPlayerController::UpdatePawnControlProjection(float DeltaTime)
@@ -118,20 +135,21 @@ void AGSPlayerController::UpdatePawnControlProjection(float DeltaTime)
 
     const FPlane ProjectionPlane(ProjectionAnchor, ProjectionNormal);
 
+    // Build view projection once for every projection in this frame
+    if (! ViewProjection.Build(this))
+    {
+        return;
+    }
+
     // Clamp mouse position within viewport
 
     // Viewport size (no DPI scale) and DPI scale
-    FVector2D ViewportSize = UWidgetLayoutLibrary::GetViewportSize(this);
-    float ViewportScale = UWidgetLayoutLibrary::GetViewportScale(this);
+    const FVector2D ViewportSize = ViewProjection.ViewportSize;
+    const float ViewportScale = ViewProjection.ViewportScale;
 
     // Anchor screen position (no DPI scale)
     FVector2D ViewportAnchor;
-    bProjectionSuccess = UGameplayStatics::ProjectWorldToScreen(
-        this,
-        ProjectionAnchor,
-        ViewportAnchor,
-        true
-        );
+    bProjectionSuccess = ViewProjection.ProjectWorldToScreen(ProjectionAnchor, ViewportAnchor);
 
     // Projection failed, possibly due to target world location
     // is out of camera (commonly during client initial possession).
@@ -175,12 +193,7 @@ void AGSPlayerController::UpdatePawnControlProjection(float DeltaTime)
     FVector MouseWorldPos;
     FVector MouseWorldDir;
 
-    UGameplayStatics::DeprojectScreenToWorld(
-        this,
-        MouseViewportPos,
-        MouseWorldPos,
-        MouseWorldDir
-        );
+    ViewProjection.DeprojectScreenToWorld(MouseViewportPos, MouseWorldPos, MouseWorldDir);
 
     FVector MouseProjected = FMath::RayPlaneIntersection(
         MouseWorldPos,
@@ -209,12 +222,7 @@ void AGSPlayerController::UpdatePawnControlProjection(float DeltaTime)
         FVector WeaponAnchorWorld(HeroCharacter->GetWeaponAttachPointLocation());
         FVector2D WeaponAnchorScreen;
 
-        UGameplayStatics::ProjectWorldToScreen(
-            this,
-            WeaponAnchorWorld,
-            WeaponAnchorScreen,
-            true
-            );
+        bProjectionSuccess = ViewProjection.ProjectWorldToScreen(WeaponAnchorWorld, WeaponAnchorScreen);
 
         // Projection failed, possibly due to target world location
         // is out of camera (commonly during client initial possession).
@@ -289,12 +297,7 @@ void AGSPlayerController::UpdatePawnControlProjection(float DeltaTime)
         FVector ViewTargetWorldPos;
         FVector ViewTargetWorldDir;
 
-        UGameplayStatics::DeprojectScreenToWorld(
-            this,
-            ViewTargetOnAnchorPos,
-            ViewTargetWorldPos,
-            ViewTargetWorldDir
-            );
+        ViewProjection.DeprojectScreenToWorld(ViewTargetOnAnchorPos, ViewTargetWorldPos, ViewTargetWorldDir);
 
         ViewDst = FMath::RayPlaneIntersection(
             ViewTargetWorldPos,
@@ -362,26 +365,14 @@ void AGSPlayerController::UpdateHUD()
         return;
     }
 
-    // Set attributes
-    UIHUDWidget->SetCurrentHealth(PS->GetHealth());
-    UIHUDWidget->SetMaxHealth(PS->GetMaxHealth());
-    UIHUDWidget->SetHealthPercentage(PS->GetHealth() / PS->GetMaxHealth());
-    UIHUDWidget->SetCurrentMana(PS->GetMana());
-    UIHUDWidget->SetMaxMana(PS->GetMaxMana());
-    UIHUDWidget->SetManaPercentage(PS->GetMana() / PS->GetMaxMana());
-    UIHUDWidget->SetHealthRegenRate(PS->GetHealthRegenRate());
-    UIHUDWidget->SetManaRegenRate(PS->GetManaRegenRate());
-    UIHUDWidget->SetCurrentStamina(PS->GetStamina());
-    UIHUDWidget->SetMaxStamina(PS->GetMaxStamina());
-    UIHUDWidget->SetStaminaPercentage(PS->GetStamina() / PS->GetMaxStamina());
-    UIHUDWidget->SetStaminaRegenRate(PS->GetStaminaRegenRate());
-    UIHUDWidget->SetCurrentShield(PS->GetShield());
-    UIHUDWidget->SetMaxShield(PS->GetMaxShield());
-    UIHUDWidget->SetShieldRegenRate(PS->GetShieldRegenRate());
-    UIHUDWidget->SetShieldPercentage(PS->GetShield() / PS->GetMaxShield());
-    UIHUDWidget->SetExperience(PS->GetXP());
-    UIHUDWidget->SetGold(PS->GetGold());
-    UIHUDWidget->SetHeroLevel(PS->GetCharacterLevel());
+    // Attributes are pushed by the view model on the next flush,
+    // binding (or rebinding) marks every attribute as dirty.
+    if (! HUDViewModel)
+    {
+        HUDViewModel = NewObject<UGSHUDViewModel>(this);
+    }
+
+    HUDViewModel->Bind(PS->GetAbilitySystemComponent());
 
     if (HeroCharacter)
     {
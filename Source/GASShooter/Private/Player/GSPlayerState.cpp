@@ -8,9 +8,9 @@
 #include "Characters/Abilities/GSAbilitySystemGlobals.h"
 #include "Characters/Heroes/GSHeroCharacter.h"
 #include "Player/GSPlayerController.h"
-#include "UI/GSFloatingStatusBarWidget.h"
 #include "UI/GSHUDWidget.h"
 #include "Weapons/GSWeapon.h"
+#include "TimerManager.h"
 
 AGSPlayerState::AGSPlayerState()
 {
@@ -36,6 +36,18 @@ AGSPlayerState::AGSPlayerState()
 
 	DeadTag = FGameplayTag::RequestGameplayTag("State.Dead");
 	KnockedDownTag = FGameplayTag::RequestGameplayTag("State.KnockedDown");
+
+	InteractionPromptHideDelay = 0.15f;
+
+	InteractionUIState = EInteractionUIState::Hidden;
+	InteractionPromptDuration = 0.0f;
+	bPromptHidePending = false;
+
+	NumRequestedPromptTransitions = 0;
+	NumAppliedPromptTransitions = 0;
+	PromptChurnWindowStartTime = 0.0f;
+	RequestedPromptTransitionsPerSecond = 0.0f;
+	AppliedPromptTransitionsPerSecond = 0.0f;
 }
 
 UAbilitySystemComponent* AGSPlayerState::GetAbilitySystemComponent() const
@@ -73,54 +85,144 @@ void AGSPlayerState::ShowAbilityConfirmPrompt(bool bShowPrompt)
 
 void AGSPlayerState::ShowInteractionPrompt(float InteractionDuration)
 {
-	AGSPlayerController* PC = Cast<AGSPlayerController>(GetOwner());
-	if (PC)
+	RecordPromptTransition(false);
+
+	if (InteractionUIState == EInteractionUIState::Prompt && InteractionPromptDuration == InteractionDuration)
 	{
-		UGSHUDWidget* HUD = PC->GetGSHUD();
-		if (HUD)
-		{
-			HUD->ShowInteractionPrompt(InteractionDuration);
-		}
+		// Already shown, this also absorbs a pending hide from a flickering target
+		CancelPendingPromptHide();
+		return;
+	}
+
+	UGSHUDWidget* HUD = GetHUDWidget();
+	if (HUD)
+	{
+		CancelPendingPromptHide();
+		InteractionUIState = EInteractionUIState::Prompt;
+		InteractionPromptDuration = InteractionDuration;
+
+		HUD->ShowInteractionPrompt(InteractionDuration);
+		RecordPromptTransition(true);
 	}
 }
 
 void AGSPlayerState::HideInteractionPrompt()
 {
-	AGSPlayerController* PC = Cast<AGSPlayerController>(GetOwner());
-	if (PC)
+	RecordPromptTransition(false);
+
+	if (InteractionUIState == EInteractionUIState::Hidden || bPromptHidePending)
 	{
-		UGSHUDWidget* HUD = PC->GetGSHUD();
-		if (HUD)
-		{
-			HUD->HideInteractionPrompt();
-		}
+		return;
+	}
+
+	if (InteractionUIState != EInteractionUIState::Prompt || InteractionPromptHideDelay <= 0.0f)
+	{
+		ApplyHideInteractionPrompt();
+		return;
+	}
+
+	bPromptHidePending = true;
+	GetWorldTimerManager().SetTimer(InteractionPromptHideTimerHandle, this, &AGSPlayerState::ApplyHideInteractionPrompt, InteractionPromptHideDelay, false);
+}
+
+void AGSPlayerState::ApplyHideInteractionPrompt()
+{
+	CancelPendingPromptHide();
+	InteractionUIState = EInteractionUIState::Hidden;
+
+	UGSHUDWidget* HUD = GetHUDWidget();
+	if (HUD)
+	{
+		HUD->HideInteractionPrompt();
+		RecordPromptTransition(true);
 	}
 }
 
 void AGSPlayerState::StartInteractionTimer(float InteractionDuration)
 {
-	AGSPlayerController* PC = Cast<AGSPlayerController>(GetOwner());
-	if (PC)
+	UGSHUDWidget* HUD = GetHUDWidget();
+	if (HUD)
 	{
-		UGSHUDWidget* HUD = PC->GetGSHUD();
-		if (HUD)
-		{
-			HUD->StartInteractionTimer(InteractionDuration);
-		}
+		CancelPendingPromptHide();
+		InteractionUIState = EInteractionUIState::Timer;
+
+		HUD->StartInteractionTimer(InteractionDuration);
 	}
 }
 
 void AGSPlayerState::StopInteractionTimer()
 {
-	AGSPlayerController* PC = Cast<AGSPlayerController>(GetOwner());
-	if (PC)
+	// The HUD hides the interact timer and prompt, the next show request will show the prompt again
+	CancelPendingPromptHide();
+	InteractionUIState = EInteractionUIState::Hidden;
+
+	UGSHUDWidget* HUD = GetHUDWidget();
+	if (HUD)
 	{
-		UGSHUDWidget* HUD = PC->GetGSHUD();
-		if (HUD)
+		HUD->StopInteractionTimer();
+	}
+}
+
+void AGSPlayerState::GetInteractionPromptChurn(float& RequestedPerSecond, float& AppliedPerSecond) const
+{
+	// Counters roll over on the next transition, no transitions for a whole window means no churn
+	if (GetWorld()->GetTimeSeconds() - PromptChurnWindowStartTime >= 2.0f)
+	{
+		RequestedPerSecond = 0.0f;
+		AppliedPerSecond = 0.0f;
+		return;
+	}
+
+	RequestedPerSecond = RequestedPromptTransitionsPerSecond;
+	AppliedPerSecond = AppliedPromptTransitionsPerSecond;
+}
+
+UGSHUDWidget* AGSPlayerState::GetHUDWidget()
+{
+	UGSHUDWidget* HUD = CachedHUDWidget.Get();
+
+	if (!HUD)
+	{
+		AGSPlayerController* PC = Cast<AGSPlayerController>(GetOwner());
+		if (PC)
 		{
-			HUD->StopInteractionTimer();
+			HUD = PC->GetGSHUD();
+			CachedHUDWidget = HUD;
 		}
 	}
+
+	return HUD;
+}
+
+void AGSPlayerState::CancelPendingPromptHide()
+{
+	bPromptHidePending = false;
+	GetWorldTimerManager().ClearTimer(InteractionPromptHideTimerHandle);
+}
+
+void AGSPlayerState::RecordPromptTransition(bool bApplied)
+{
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	const float WindowDuration = CurrentTime - PromptChurnWindowStartTime;
+
+	if (WindowDuration >= 1.0f)
+	{
+		RequestedPromptTransitionsPerSecond = NumRequestedPromptTransitions / WindowDuration;
+		AppliedPromptTransitionsPerSecond = NumAppliedPromptTransitions / WindowDuration;
+
+		NumRequestedPromptTransitions = 0;
+		NumAppliedPromptTransitions = 0;
+		PromptChurnWindowStartTime = CurrentTime;
+	}
+
+	if (bApplied)
+	{
+		++NumAppliedPromptTransitions;
+	}
+	else
+	{
+		++NumRequestedPromptTransitions;
+	}
 }
 
 float AGSPlayerState::GetHealth() const
@@ -258,6 +360,13 @@ void AGSPlayerState::BeginPlay()
 	}
 }
 
+void AGSPlayerState::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorldTimerManager().ClearTimer(InteractionPromptHideTimerHandle);
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AGSPlayerState::HealthChanged(const FOnAttributeChangeData& Data)
 {
 	// Check for and handle knockdown and death
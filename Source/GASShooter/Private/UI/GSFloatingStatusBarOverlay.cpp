@@ -0,0 +1,249 @@
+// Copyright 2021 Nuraga Wiswakarma.
+
+#include "UI/GSFloatingStatusBarOverlay.h"
+#include "CanvasItem.h"
+#include "Engine/Canvas.h"
+#include "Engine/Engine.h"
+#include "Engine/Font.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+#include "Characters/GSCharacterBase.h"
+#include "UI/GSViewProjection.h"
+
+void FGSFloatingStatusBarOverlay::Register(AGSCharacterBase* Character, const FText& Name)
+{
+    if (! IsValid(Character) || IsRegistered(Character))
+    {
+        return;
+    }
+
+    FEntry& Entry = Entries.AddDefaulted_GetRef();
+    Entry.Character = Character;
+    Entry.Name = Name;
+}
+
+void FGSFloatingStatusBarOverlay::Unregister(AGSCharacterBase* Character)
+{
+    Entries.RemoveAllSwap([Character](const FEntry& Entry)
+    {
+        return Entry.Character.Get() == Character;
+    });
+}
+
+bool FGSFloatingStatusBarOverlay::IsRegistered(const AGSCharacterBase* Character) const
+{
+    return Entries.ContainsByPredicate([Character](const FEntry& Entry)
+    {
+        return Entry.Character.Get() == Character;
+    });
+}
+
+void FGSFloatingStatusBarOverlay::Reset()
+{
+    Entries.Reset();
+    VisibleBars.Reset();
+}
+
+void FGSFloatingStatusBarOverlay::UpdateEntry(
+    FEntry& Entry,
+    AGSCharacterBase* Character,
+    const FVector& ViewLocation,
+    const FVector& BarLocation,
+    const APlayerController* PlayerController,
+    const FGSFloatingStatusBarSettings& Settings
+    )
+{
+    auto GetRatio = [](float Value, float MaxValue)
+    {
+        return MaxValue > 0.0f ? FMath::Clamp(Value / MaxValue, 0.0f, 1.0f) : 0.0f;
+    };
+
+    Entry.HealthPercentage = GetRatio(Character->GetHealth(), Character->GetMaxHealth());
+    Entry.ManaPercentage = GetRatio(Character->GetMana(), Character->GetMaxMana());
+    Entry.ShieldPercentage = GetRatio(Character->GetShield(), Character->GetMaxShield());
+
+    UWorld* World = Character->GetWorld();
+
+    if (Settings.bOcclusionCulling)
+    {
+        FCollisionQueryParams Params(SCENE_QUERY_STAT(GSFloatingStatusBarOcclusion), false);
+        Params.AddIgnoredActor(Character);
+        Params.AddIgnoredActor(PlayerController->GetPawn());
+
+        Entry.bOccluded = World->LineTraceTestByChannel(
+            ViewLocation,
+            BarLocation,
+            Settings.OcclusionTraceChannel,
+            Params
+            );
+    }
+    else
+    {
+        Entry.bOccluded = false;
+    }
+
+    // Update interval grows linearly from every frame at near distance
+    // to the far interval at max draw distance
+
+    const float Distance = FVector::Dist(ViewLocation, BarLocation);
+    const float DistanceRange = FMath::Max(Settings.MaxDrawDistance - Settings.NearDistance, KINDA_SMALL_NUMBER);
+    const float DistanceAlpha = FMath::Clamp((Distance - Settings.NearDistance) / DistanceRange, 0.0f, 1.0f);
+
+    Entry.NextUpdateTime = World->GetTimeSeconds() + DistanceAlpha * Settings.FarUpdateInterval;
+}
+
+void FGSFloatingStatusBarOverlay::Draw(
+    UCanvas* Canvas,
+    const FGSViewProjectionSnapshot& ViewProjection,
+    const APlayerController* PlayerController,
+    const FGSFloatingStatusBarSettings& Settings
+    )
+{
+    QUICK_SCOPE_CYCLE_COUNTER(STAT_GSFloatingStatusBarOverlay_Draw);
+
+    // Drop destroyed characters
+    Entries.RemoveAllSwap([](const FEntry& Entry)
+    {
+        return ! Entry.Character.IsValid();
+    });
+
+    if (! Canvas || ! Canvas->Canvas || ! PlayerController || ! ViewProjection.IsCurrent() || Entries.Num() < 1)
+    {
+        return;
+    }
+
+    FVector ViewLocation;
+    FRotator ViewRotation;
+    PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+    const float CurrentTime = PlayerController->GetWorld()->GetTimeSeconds();
+    const float MaxDrawDistanceSq = FMath::Square(Settings.MaxDrawDistance);
+
+    const FVector2D BarSize = Settings.BarSize;
+    const float RowHeight = Settings.SecondaryBarHeight + Settings.BarSpacing;
+    const float TotalHeight = BarSize.Y + RowHeight * 2.0f;
+
+    // Cull and refresh
+
+    VisibleBars.Reset();
+
+    for (int32 i = 0; i < Entries.Num(); ++i)
+    {
+        FEntry& Entry = Entries[i];
+        AGSCharacterBase* Character = Entry.Character.Get();
+
+        if (! Character->IsAlive() || Character->IsHidden())
+        {
+            continue;
+        }
+
+        const FVector BarLocation = Character->GetActorLocation() + Settings.WorldOffset;
+
+        if (FVector::DistSquared(ViewLocation, BarLocation) > MaxDrawDistanceSq)
+        {
+            continue;
+        }
+
+        FVector2D CanvasLocation;
+
+        if (! ViewProjection.ProjectWorldToCanvas(BarLocation, CanvasLocation))
+        {
+            continue;
+        }
+
+        // Off screen, bars are centered horizontally and anchored at the bottom
+        if (CanvasLocation.X + BarSize.X * 0.5f < 0.0f ||
+            CanvasLocation.X - BarSize.X * 0.5f > Canvas->ClipX ||
+            CanvasLocation.Y < 0.0f ||
+            CanvasLocation.Y - TotalHeight > Canvas->ClipY)
+        {
+            continue;
+        }
+
+        if (CurrentTime >= Entry.NextUpdateTime)
+        {
+            UpdateEntry(Entry, Character, ViewLocation, BarLocation, PlayerController, Settings);
+        }
+
+        if (Entry.bOccluded)
+        {
+            continue;
+        }
+
+        FVisibleBar& VisibleBar = VisibleBars.AddDefaulted_GetRef();
+        VisibleBar.Position = FVector2D(
+            FMath::RoundToFloat(CanvasLocation.X - BarSize.X * 0.5f),
+            FMath::RoundToFloat(CanvasLocation.Y - TotalHeight)
+            );
+        VisibleBar.EntryIndex = i;
+    }
+
+    if (VisibleBars.Num() < 1)
+    {
+        return;
+    }
+
+    // Draw each layer for every bar before the next layer so consecutive
+    // tiles share the same batched element
+
+    FCanvasTileItem TileItem(FVector2D::ZeroVector, GWhiteTexture, FLinearColor::White);
+    TileItem.BlendMode = SE_BLEND_Translucent;
+
+    auto DrawTile = [&](const FVector2D& Position, const FVector2D& Size, const FLinearColor& Color)
+    {
+        if (Size.X > 0.0f)
+        {
+            TileItem.Position = Position;
+            TileItem.Size = Size;
+            TileItem.SetColor(Color);
+            Canvas->DrawItem(TileItem);
+        }
+    };
+
+    const FVector2D HealthOffset(0.0f, 0.0f);
+    const FVector2D ShieldOffset(0.0f, BarSize.Y + Settings.BarSpacing);
+    const FVector2D ManaOffset(0.0f, ShieldOffset.Y + RowHeight);
+
+    for (const FVisibleBar& VisibleBar : VisibleBars)
+    {
+        DrawTile(VisibleBar.Position + HealthOffset, BarSize, Settings.BackgroundColor);
+        DrawTile(VisibleBar.Position + ShieldOffset, FVector2D(BarSize.X, Settings.SecondaryBarHeight), Settings.BackgroundColor);
+        DrawTile(VisibleBar.Position + ManaOffset, FVector2D(BarSize.X, Settings.SecondaryBarHeight), Settings.BackgroundColor);
+    }
+
+    for (const FVisibleBar& VisibleBar : VisibleBars)
+    {
+        const FEntry& Entry = Entries[VisibleBar.EntryIndex];
+
+        DrawTile(VisibleBar.Position + HealthOffset, FVector2D(BarSize.X * Entry.HealthPercentage, BarSize.Y), Settings.HealthColor);
+        DrawTile(VisibleBar.Position + ShieldOffset, FVector2D(BarSize.X * Entry.ShieldPercentage, Settings.SecondaryBarHeight), Settings.ShieldColor);
+        DrawTile(VisibleBar.Position + ManaOffset, FVector2D(BarSize.X * Entry.ManaPercentage, Settings.SecondaryBarHeight), Settings.ManaColor);
+    }
+
+    // Names
+
+    UFont* NameFont = Settings.NameFont ? Settings.NameFont : GEngine->GetSmallFont();
+
+    if (! NameFont)
+    {
+        return;
+    }
+
+    const float NameOffsetY = NameFont->GetMaxCharHeight() + Settings.BarSpacing;
+
+    FCanvasTextItem TextItem(FVector2D::ZeroVector, FText::GetEmpty(), NameFont, Settings.NameColor);
+    TextItem.bCentreX = true;
+    TextItem.EnableShadow(FLinearColor::Black);
+
+    for (const FVisibleBar& VisibleBar : VisibleBars)
+    {
+        const FEntry& Entry = Entries[VisibleBar.EntryIndex];
+
+        if (! Entry.Name.IsEmpty())
+        {
+            TextItem.Text = Entry.Name;
+            Canvas->DrawItem(TextItem, VisibleBar.Position.X + BarSize.X * 0.5f, VisibleBar.Position.Y - NameOffsetY);
+        }
+    }
+}
@@ -1,5 +0,0 @@
-// Copyright 2020 Dan Kestranek.
-
-
-#include "UI/GSFloatingStatusBarWidget.h"
-
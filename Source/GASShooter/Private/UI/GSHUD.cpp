@@ -2,8 +2,65 @@
 
 
 #include "UI/GSHUD.h"
+#include "Engine/Canvas.h"
+#include "EngineUtils.h"
 #include "PaperSprite.h"
 
+#include "Characters/Heroes/GSHeroCharacter.h"
+
+void AGSHUD::BeginPlay()
+{
+    Super::BeginPlay();
+
+    // Heroes initialized before the HUD was spawned
+    for (TActorIterator<AGSHeroCharacter> It(GetWorld()); It; ++It)
+    {
+        It->InitializeFloatingStatusBar();
+    }
+}
+
+void AGSHUD::DrawHUD()
+{
+    Super::DrawHUD();
+
+    if (UpdateCanvasViewProjection())
+    {
+        FloatingStatusBars.Draw(Canvas, CanvasViewProjection, PlayerOwner, FloatingStatusBarSettings);
+    }
+}
+
+void AGSHUD::RegisterFloatingStatusBar(AGSCharacterBase* Character, const FText& Name)
+{
+    FloatingStatusBars.Register(Character, Name);
+}
+
+void AGSHUD::UnregisterFloatingStatusBar(AGSCharacterBase* Character)
+{
+    FloatingStatusBars.Unregister(Character);
+}
+
+bool AGSHUD::IsFloatingStatusBarRegistered(const AGSCharacterBase* Character) const
+{
+    return FloatingStatusBars.IsRegistered(Character);
+}
+
+bool AGSHUD::UpdateCanvasViewProjection()
+{
+    // Canvas is only valid while drawing the HUD. The snapshot is built
+    // from the canvas scene view since it is the final view of this frame.
+    if (! Canvas)
+    {
+        return false;
+    }
+
+    if (! CanvasViewProjection.IsCurrent())
+    {
+        CanvasViewProjection.Build(Canvas->SceneView, FVector2D(Canvas->ClipX, Canvas->ClipY));
+    }
+
+    return CanvasViewProjection.IsCurrent();
+}
+
 void AGSHUD::ProjectBoundsByExtents(
     const FVector& Origin,
     const FVector& Extents,
@@ -15,14 +72,10 @@ void AGSHUD::ProjectBoundsByExtents(
 {
     FBox2D Bounds2D(ForceInitToZero);
 
-    Bounds2D += FVector2D(Project(Origin+FVector(-Extents.X, -Extents.Y, -Extents.Z)));
-    Bounds2D += FVector2D(Project(Origin+FVector( Extents.X, -Extents.Y, -Extents.Z)));
-    Bounds2D += FVector2D(Project(Origin+FVector(-Extents.X,  Extents.Y, -Extents.Z)));
-    Bounds2D += FVector2D(Project(Origin+FVector(-Extents.X, -Extents.Y,  Extents.Z)));
-    Bounds2D += FVector2D(Project(Origin+FVector(-Extents.X,  Extents.Y,  Extents.Z)));
-    Bounds2D += FVector2D(Project(Origin+FVector( Extents.X, -Extents.Y,  Extents.Z)));
-    Bounds2D += FVector2D(Project(Origin+FVector( Extents.X,  Extents.Y, -Extents.Z)));
-    Bounds2D += FVector2D(Project(Origin+FVector( Extents.X,  Extents.Y,  Extents.Z)));
+    if (UpdateCanvasViewProjection())
+    {
+        Bounds2D = CanvasViewProjection.ProjectBoxBounds(Origin, Extents);
+    }
 
     OutScreenTL = Bounds2D.Min;
     OutScreenTR = FVector2D(Bounds2D.Max.X, Bounds2D.Min.Y);
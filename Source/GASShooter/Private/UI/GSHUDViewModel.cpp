@@ -0,0 +1,216 @@
+// Copyright 2021 Nuraga Wiswakarma.
+
+#include "UI/GSHUDViewModel.h"
+#include "Characters/Abilities/GSAbilitySystemComponent.h"
+#include "Characters/Abilities/AttributeSets/GSAttributeSetBase.h"
+#include "UI/GSHUDWidget.h"
+
+void UGSHUDViewModel::Bind(UAbilitySystemComponent* InAbilitySystemComponent)
+{
+    UGSAbilitySystemComponent* ASC = Cast<UGSAbilitySystemComponent>(InAbilitySystemComponent);
+
+    if (ASC && AbilitySystemComponent.Get() == ASC)
+    {
+        MarkAllDirty();
+        return;
+    }
+
+    Unbind();
+
+    if (! IsValid(ASC))
+    {
+        return;
+    }
+
+    AbilitySystemComponent = ASC;
+
+    Attributes[Health] = UGSAttributeSetBase::GetHealthAttribute();
+    Attributes[MaxHealth] = UGSAttributeSetBase::GetMaxHealthAttribute();
+    Attributes[HealthRegenRate] = UGSAttributeSetBase::GetHealthRegenRateAttribute();
+    Attributes[Mana] = UGSAttributeSetBase::GetManaAttribute();
+    Attributes[MaxMana] = UGSAttributeSetBase::GetMaxManaAttribute();
+    Attributes[ManaRegenRate] = UGSAttributeSetBase::GetManaRegenRateAttribute();
+    Attributes[Stamina] = UGSAttributeSetBase::GetStaminaAttribute();
+    Attributes[MaxStamina] = UGSAttributeSetBase::GetMaxStaminaAttribute();
+    Attributes[StaminaRegenRate] = UGSAttributeSetBase::GetStaminaRegenRateAttribute();
+    Attributes[Shield] = UGSAttributeSetBase::GetShieldAttribute();
+    Attributes[MaxShield] = UGSAttributeSetBase::GetMaxShieldAttribute();
+    Attributes[ShieldRegenRate] = UGSAttributeSetBase::GetShieldRegenRateAttribute();
+    Attributes[XP] = UGSAttributeSetBase::GetXPAttribute();
+    Attributes[Gold] = UGSAttributeSetBase::GetGoldAttribute();
+    Attributes[CharacterLevel] = UGSAttributeSetBase::GetCharacterLevelAttribute();
+
+    ListenerHandle = ASC->GetListenerHub().ListenForAttributes(
+        MakeArrayView(Attributes, NumAttributes),
+        FGSAttributeListenerDelegate::CreateUObject(this, &UGSHUDViewModel::AttributeChanged)
+        );
+
+    MarkAllDirty();
+}
+
+void UGSHUDViewModel::Unbind()
+{
+    UGSAbilitySystemComponent* ASC = AbilitySystemComponent.Get();
+
+    if (ASC)
+    {
+        ASC->GetListenerHub().RemoveListener(ListenerHandle);
+    }
+
+    ListenerHandle.Reset();
+
+    AbilitySystemComponent.Reset();
+    DirtyMask = 0;
+}
+
+bool UGSHUDViewModel::IsBound() const
+{
+    return AbilitySystemComponent.IsValid();
+}
+
+void UGSHUDViewModel::MarkAllDirty()
+{
+    DirtyMask = (1u << NumAttributes) - 1;
+}
+
+void UGSHUDViewModel::AttributeChanged(const FGameplayAttribute& Attribute, float NewValue, float OldValue)
+{
+    // Only flag the value, it is read from the ability system on flush
+    // so multiple changes within a frame are coalesced into one push.
+    for (int32 i = 0; i < NumAttributes; ++i)
+    {
+        if (Attributes[i] == Attribute)
+        {
+            DirtyMask |= (1u << i);
+            break;
+        }
+    }
+}
+
+float UGSHUDViewModel::GetAttributeValue(EHUDAttribute Attribute) const
+{
+    return AbilitySystemComponent->GetNumericAttribute(Attributes[Attribute]);
+}
+
+void UGSHUDViewModel::Flush(UGSHUDWidget* Widget)
+{
+    if (! DirtyMask || ! IsValid(Widget) || ! AbilitySystemComponent.IsValid())
+    {
+        return;
+    }
+
+    QUICK_SCOPE_CYCLE_COUNTER(STAT_GSHUDViewModel_Flush);
+
+    const uint32 Mask = DirtyMask;
+    DirtyMask = 0;
+
+    auto GetRatio = [](float Value, float MaxValue)
+    {
+        return MaxValue > 0.0f ? (Value / MaxValue) : 0.0f;
+    };
+
+    // Health
+
+    if (IsAttributeDirty(Mask, Health))
+    {
+        Widget->SetCurrentHealth(GetAttributeValue(Health));
+    }
+
+    if (IsAttributeDirty(Mask, MaxHealth))
+    {
+        Widget->SetMaxHealth(GetAttributeValue(MaxHealth));
+    }
+
+    if (IsAttributeDirty(Mask, Health) || IsAttributeDirty(Mask, MaxHealth))
+    {
+        Widget->SetHealthPercentage(GetRatio(GetAttributeValue(Health), GetAttributeValue(MaxHealth)));
+    }
+
+    if (IsAttributeDirty(Mask, HealthRegenRate))
+    {
+        Widget->SetHealthRegenRate(GetAttributeValue(HealthRegenRate));
+    }
+
+    // Mana
+
+    if (IsAttributeDirty(Mask, Mana))
+    {
+        Widget->SetCurrentMana(GetAttributeValue(Mana));
+    }
+
+    if (IsAttributeDirty(Mask, MaxMana))
+    {
+        Widget->SetMaxMana(GetAttributeValue(MaxMana));
+    }
+
+    if (IsAttributeDirty(Mask, Mana) || IsAttributeDirty(Mask, MaxMana))
+    {
+        Widget->SetManaPercentage(GetRatio(GetAttributeValue(Mana), GetAttributeValue(MaxMana)));
+    }
+
+    if (IsAttributeDirty(Mask, ManaRegenRate))
+    {
+        Widget->SetManaRegenRate(GetAttributeValue(ManaRegenRate));
+    }
+
+    // Stamina
+
+    if (IsAttributeDirty(Mask, Stamina))
+    {
+        Widget->SetCurrentStamina(GetAttributeValue(Stamina));
+    }
+
+    if (IsAttributeDirty(Mask, MaxStamina))
+    {
+        Widget->SetMaxStamina(GetAttributeValue(MaxStamina));
+    }
+
+    if (IsAttributeDirty(Mask, Stamina) || IsAttributeDirty(Mask, MaxStamina))
+    {
+        Widget->SetStaminaPercentage(GetRatio(GetAttributeValue(Stamina), GetAttributeValue(MaxStamina)));
+    }
+
+    if (IsAttributeDirty(Mask, StaminaRegenRate))
+    {
+        Widget->SetStaminaRegenRate(GetAttributeValue(StaminaRegenRate));
+    }
+
+    // Shield
+
+    if (IsAttributeDirty(Mask, Shield))
+    {
+        Widget->SetCurrentShield(GetAttributeValue(Shield));
+    }
+
+    if (IsAttributeDirty(Mask, MaxShield))
+    {
+        Widget->SetMaxShield(GetAttributeValue(MaxShield));
+    }
+
+    if (IsAttributeDirty(Mask, Shield) || IsAttributeDirty(Mask, MaxShield))
+    {
+        Widget->SetShieldPercentage(GetRatio(GetAttributeValue(Shield), GetAttributeValue(MaxShield)));
+    }
+
+    if (IsAttributeDirty(Mask, ShieldRegenRate))
+    {
+        Widget->SetShieldRegenRate(GetAttributeValue(ShieldRegenRate));
+    }
+
+    // Progression
+
+    if (IsAttributeDirty(Mask, XP))
+    {
+        Widget->SetExperience(static_cast<int32>(GetAttributeValue(XP)));
+    }
+
+    if (IsAttributeDirty(Mask, Gold))
+    {
+        Widget->SetGold(static_cast<int32>(GetAttributeValue(Gold)));
+    }
+
+    if (IsAttributeDirty(Mask, CharacterLevel))
+    {
+        Widget->SetHeroLevel(static_cast<int32>(GetAttributeValue(CharacterLevel)));
+    }
+}
@@ -0,0 +1,156 @@
+// Copyright 2021 Nuraga Wiswakarma.
+
+#include "UI/GSViewProjection.h"
+#include "Blueprint/WidgetLayoutLibrary.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+#include "SceneView.h"
+
+bool FGSViewProjectionSnapshot::Build(const APlayerController* PlayerController)
+{
+    bIsValid = false;
+
+    ULocalPlayer* const LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+
+    if (! LocalPlayer || ! LocalPlayer->ViewportClient)
+    {
+        return false;
+    }
+
+    FSceneViewProjectionData ProjectionData;
+
+    if (! LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, eSSP_FULL, ProjectionData))
+    {
+        return false;
+    }
+
+    ViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+    InvViewProjectionMatrix = ViewProjectionMatrix.InverseFast();
+    ViewRect = ProjectionData.GetConstrainedViewRect();
+
+    LocalPlayer->ViewportClient->GetViewportSize(ViewportSize);
+    ViewportScale = UWidgetLayoutLibrary::GetViewportScale(LocalPlayer->ViewportClient);
+
+    FrameNumber = GFrameCounter;
+    bIsValid = true;
+
+    return true;
+}
+
+bool FGSViewProjectionSnapshot::Build(const FSceneView* SceneView, const FVector2D& CanvasSize)
+{
+    bIsValid = false;
+
+    if (! SceneView)
+    {
+        return false;
+    }
+
+    ViewProjectionMatrix = SceneView->ViewMatrices.GetViewProjectionMatrix();
+    InvViewProjectionMatrix = SceneView->ViewMatrices.GetInvViewProjectionMatrix();
+    ViewRect = SceneView->UnscaledViewRect;
+
+    ViewportSize = CanvasSize;
+    ViewportScale = 1.0f;
+
+    FrameNumber = GFrameCounter;
+    bIsValid = true;
+
+    return true;
+}
+
+bool FGSViewProjectionSnapshot::ProjectWorldToScreen(const FVector& WorldLocation, FVector2D& OutScreenLocation) const
+{
+    const FPlane Result = ViewProjectionMatrix.TransformFVector4(FVector4(WorldLocation, 1.0f));
+
+    if (Result.W > 0.0f)
+    {
+        const float RHW = 1.0f / Result.W;
+        const float NormalizedX = (Result.X * RHW * 0.5f) + 0.5f;
+        const float NormalizedY = 0.5f - (Result.Y * RHW * 0.5f);
+
+        // Player viewport relative position
+        OutScreenLocation.X = NormalizedX * ViewRect.Width();
+        OutScreenLocation.Y = NormalizedY * ViewRect.Height();
+
+        return true;
+    }
+
+    OutScreenLocation = FVector2D::ZeroVector;
+
+    return false;
+}
+
+bool FGSViewProjectionSnapshot::ProjectWorldToCanvas(const FVector& WorldLocation, FVector2D& OutCanvasLocation) const
+{
+    const FPlane Result = ViewProjectionMatrix.TransformFVector4(FVector4(WorldLocation, 1.0f));
+
+    if (Result.W > 0.0f)
+    {
+        const float RHW = 1.0f / Result.W;
+        const FVector2D HalfSize = ViewportSize * 0.5f;
+
+        OutCanvasLocation.X = HalfSize.X + (Result.X * RHW * HalfSize.X);
+        OutCanvasLocation.Y = HalfSize.Y - (Result.Y * RHW * HalfSize.Y);
+
+        return true;
+    }
+
+    OutCanvasLocation = FVector2D::ZeroVector;
+
+    return false;
+}
+
+bool FGSViewProjectionSnapshot::DeprojectScreenToWorld(const FVector2D& ScreenLocation, FVector& OutWorldLocation, FVector& OutWorldDirection) const
+{
+    if (! bIsValid)
+    {
+        OutWorldLocation = FVector::ZeroVector;
+        OutWorldDirection = FVector::ZeroVector;
+        return false;
+    }
+
+    FSceneView::DeprojectScreenToWorld(
+        ScreenLocation,
+        ViewRect,
+        InvViewProjectionMatrix,
+        OutWorldLocation,
+        OutWorldDirection
+        );
+
+    return true;
+}
+
+FBox2D FGSViewProjectionSnapshot::ProjectBoxBounds(const FVector& Origin, const FVector& Extents) const
+{
+    // Box corners are Origin +/- Extents on each axis. Projection is linear
+    // before the perspective divide, so transform the origin and the three
+    // extent axes once and combine them for every corner.
+
+    const FVector4 ClipOrigin = ViewProjectionMatrix.TransformFVector4(FVector4(Origin, 1.0f));
+    const FVector4 ClipAxisX = ViewProjectionMatrix.TransformFVector4(FVector4(Extents.X, 0.0f, 0.0f, 0.0f));
+    const FVector4 ClipAxisY = ViewProjectionMatrix.TransformFVector4(FVector4(0.0f, Extents.Y, 0.0f, 0.0f));
+    const FVector4 ClipAxisZ = ViewProjectionMatrix.TransformFVector4(FVector4(0.0f, 0.0f, Extents.Z, 0.0f));
+
+    const FVector2D HalfSize = ViewportSize * 0.5f;
+
+    FBox2D Bounds2D(ForceInit);
+
+    for (int32 i = 0; i < 8; ++i)
+    {
+        const float SignX = (i & 1) ? 1.0f : -1.0f;
+        const float SignY = (i & 2) ? 1.0f : -1.0f;
+        const float SignZ = (i & 4) ? 1.0f : -1.0f;
+
+        const FVector4 Clip = ClipOrigin + ClipAxisX*SignX + ClipAxisY*SignY + ClipAxisZ*SignZ;
+        const float RHW = 1.0f / (Clip.W != 0.0f ? Clip.W : KINDA_SMALL_NUMBER);
+
+        Bounds2D += FVector2D(
+            HalfSize.X + (Clip.X * RHW * HalfSize.X),
+            HalfSize.Y - (Clip.Y * RHW * HalfSize.Y)
+            );
+    }
+
+    return Bounds2D;
+}
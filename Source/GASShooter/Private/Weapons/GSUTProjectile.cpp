@@ -2,14 +2,30 @@
 
 #include "Weapons/GSUTProjectile.h"
 #include "Weapons/GSUTProjectileMovementComponent.h"
+#include "Characters/GSCharacterBase.h"
 #include "Player/GSPlayerController.h"
+#include "GSBlueprintFunctionLibrary.h"
+#include "GASShooter/GASShooter.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
 #include "Components/LightComponent.h"
 #include "Components/AudioComponent.h"
 #include "Engine/ActorChannel.h"
+#include "GameFramework/GameStateBase.h"
 #include "GameFramework/GameUserSettings.h"
 #include "Net/UnrealNetwork.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "ParticleEmitterInstances.h"
+#include "UObject/CoreNet.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "EngineUtils.h"
+#include "Characters/Heroes/GSHeroCharacter.h"
+#include "Characters/Abilities/AttributeSets/GSAttributeSetBase.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 //#include "UTImpactEffect.h"
 //#include "UTTeleporter.h"
 //#include "UTWorldSettings.h"
@@ -24,6 +40,33 @@
 
 //DEFINE_LOG_CATEGORY_STATIC(LogUTProjectile, Log, All);
 
+#if !UE_BUILD_SHIPPING
+
+// Server side projectile state at one net update, recorded by GS.Projectile.RecordRepMovement
+struct FGSRecordedProjMovement
+{
+    uint32 ProjectileId;
+    FVector Location;
+    FRotator Rotation;
+    FVector LinearVelocity;
+    bool bRotationFollowsVelocity;
+
+    friend FArchive& operator<<(FArchive& Ar, FGSRecordedProjMovement& Sample)
+    {
+        Ar << Sample.ProjectileId;
+        Ar << Sample.Location;
+        Ar << Sample.Rotation;
+        Ar << Sample.LinearVelocity;
+        Ar << Sample.bRotationFollowsVelocity;
+        return Ar;
+    }
+};
+
+static bool GGSRecordRepMovement = false;
+static TArray<FGSRecordedProjMovement> GGSRecordedRepMovement;
+
+#endif // !UE_BUILD_SHIPPING
+
 AGSUTProjectile::AGSUTProjectile(const class FObjectInitializer& ObjectInitializer) 
     : Super(ObjectInitializer)
 {
@@ -87,6 +130,11 @@ AGSUTProjectile::AGSUTProjectile(const class FObjectInitializer& ObjectInitializ
     bIsEnergyProjectile = false;
     bFakeClientProjectile = false;
     bReplicateUTMovement = false;
+    RepMovementQuantization = EGSProjMovementQuantization::Default;
+    BallisticReplayStep = 1.f / 60.f;
+    bBallisticReplayActive = false;
+    bBallisticReplayIntegrating = false;
+    BallisticReplayTime = 0.f;
     SetReplicateMovement(false);
     bMoveFakeToReplicatedPos = true;
     bCanHitTeammates = false;
@@ -250,6 +298,11 @@ void AGSUTProjectile::BeginPlay()
     {
         ProjectileMovement->Velocity.Z += TossZ;
 
+        if (UsesBallisticReplay())
+        {
+            InitBallisticLaunch();
+        }
+
         UNetDriver* NetDriver = GetNetDriver();
         if (NetDriver != NULL && NetDriver->IsServer())
         {
@@ -290,9 +343,10 @@ void AGSUTProjectile::BeginPlay()
         if (MyPlayer)
         {
             // Move projectile to match where it is on server now (to make up for replication time)
+            // Ballistic replay already places the projectile at the current server time.
             float CatchupTickDelta = MyPlayer->GetPredictionTime();
 
-            if (CatchupTickDelta > 0.f)
+            if ((CatchupTickDelta > 0.f) && !bBallisticReplayActive)
             {
                 CatchupTick(CatchupTickDelta);
             }
@@ -389,7 +443,12 @@ bool AGSUTProjectile::CanMatchFake(AGSUTProjectile* InFakeProjectile, const FVec
 
 void AGSUTProjectile::CatchupTick(float CatchupTickDelta)
 {
-    if (ProjectileMovement)
+    UGSUTProjectileMovementComponent* UTMovement = Cast<UGSUTProjectileMovementComponent>(ProjectileMovement);
+    if (UTMovement)
+    {
+        UTMovement->CatchupTick(CatchupTickDelta);
+    }
+    else if (ProjectileMovement)
     {
         ProjectileMovement->TickComponent(CatchupTickDelta, LEVELTICK_All, NULL);
     }
@@ -530,6 +589,11 @@ void AGSUTProjectile::TickActor(float DeltaTime, ELevelTick TickType, FActorTick
     }
     else
     {
+        if (bBallisticReplayActive && !bExploded)
+        {
+            TickBallisticReplay();
+        }
+
         if (OffsetVisualComponent)
         {
             float Pct = FMath::Max((GetWorld()->GetTimeSeconds() - CreationTime) / OffsetTime, 0.f);
@@ -569,10 +633,31 @@ void AGSUTProjectile::GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>
     //DOREPLIFETIME(AActor, Instigator);
     DOREPLIFETIME_CONDITION(AGSUTProjectile, GSUTProjReplicatedMovement, COND_SimulatedOrPhysics);
     DOREPLIFETIME(AGSUTProjectile, Slomo);
+    DOREPLIFETIME_CONDITION(AGSUTProjectile, GSUTProjLaunch, COND_InitialOnly);
 }
 
 void AGSUTProjectile::PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker)
 {
+#if !UE_BUILD_SHIPPING
+    // Record every net update regardless of the quantization mode, the benchmark compares all modes on the same trajectories
+    if (GGSRecordRepMovement && GetLocalRole() == ROLE_Authority && RootComponent && !RootComponent->GetAttachParent())
+    {
+        FGSRecordedProjMovement& Sample = GGSRecordedRepMovement.AddDefaulted_GetRef();
+        Sample.ProjectileId = GetUniqueID();
+        Sample.Location = RootComponent->GetComponentLocation();
+        Sample.Rotation = RootComponent->GetComponentRotation();
+        Sample.LinearVelocity = GetVelocity();
+        Sample.bRotationFollowsVelocity = ProjectileMovement && ProjectileMovement->bRotationFollowsVelocity;
+    }
+#endif // !UE_BUILD_SHIPPING
+
+    // Ballistic replay clients simulate from GSUTProjLaunch, only the final (explosion) state is sent
+    if (UsesBallisticReplay() && !bExploded)
+    {
+        bForceNextRepMovement = false;
+        return;
+    }
+
     if ((bForceNextRepMovement || bReplicateUTMovement) && (GetLocalRole() == ROLE_Authority))
     {
         GatherCurrentMovement();
@@ -605,6 +690,11 @@ void AGSUTProjectile::GatherCurrentMovement()
             GSUTProjReplicatedMovement.Location = RootComponent->GetComponentLocation();
             GSUTProjReplicatedMovement.Rotation = RootComponent->GetComponentRotation();
             GSUTProjReplicatedMovement.LinearVelocity = GetVelocity();
+            GSUTProjReplicatedMovement.Quantization = RepMovementQuantization;
+            GSUTProjReplicatedMovement.bRotationFromVelocity =
+                (RepMovementQuantization != EGSProjMovementQuantization::Default)
+                && ProjectileMovement
+                && ProjectileMovement->bRotationFollowsVelocity;
         }
     }
 }
@@ -613,6 +703,12 @@ void AGSUTProjectile::OnRep_GSUTProjReplicatedMovement()
 {
     if (GetLocalRole() == ROLE_SimulatedProxy)
     {
+        // authoritative state received (explosion), stop replaying
+        if (bBallisticReplayActive)
+        {
+            StopBallisticReplay();
+        }
+
         //ReplicatedAccel = UTReplicatedMovement.Acceleration;
         FRepMovement& RepMove(GetReplicatedMovement_Mutable());
         RepMove.Location = GSUTProjReplicatedMovement.Location;
@@ -652,7 +748,7 @@ void AGSUTProjectile::PostNetReceiveLocationAndRotation()
             float CatchupTickDelta = MyPlayer->GetPredictionTime();
             if ((CatchupTickDelta > 0.f) && ProjectileMovement)
             {
-                ProjectileMovement->TickComponent(CatchupTickDelta, LEVELTICK_All, NULL);
+                CatchupTick(CatchupTickDelta);
             }
         }
     }
@@ -692,8 +788,131 @@ void AGSUTProjectile::PostNetReceiveVelocity(const FVector& NewVelocity)
     }
 }
 
+void AGSUTProjectile::OnRep_GSUTProjLaunch()
+{
+    if ((GetLocalRole() != ROLE_SimulatedProxy) || !UsesBallisticReplay() || !GSUTProjLaunch.IsValid() || bExploded)
+    {
+        return;
+    }
+
+    ProjectileMovement->ProjectileGravityScale = GSUTProjLaunch.GravityScale;
+    ProjectileMovement->Velocity = GSUTProjLaunch.Velocity;
+    ProjectileMovement->SetComponentTickEnabled(false);
+
+    // start from the launch origin, TickBallisticReplay() moves us to the current server time
+    SetActorLocation(GSUTProjLaunch.Origin, false, nullptr, ETeleportType::TeleportPhysics);
+
+    bBallisticReplayActive = true;
+    bBallisticReplayIntegrating = false;
+    BallisticReplayTime = 0.f;
+
+    TickBallisticReplay();
+}
+
+void AGSUTProjectile::InitBallisticLaunch()
+{
+    GSUTProjLaunch.ServerSpawnTime = GetBallisticReplayServerTime();
+    GSUTProjLaunch.Origin = GetActorLocation();
+    GSUTProjLaunch.Velocity = ProjectileMovement->Velocity;
+    GSUTProjLaunch.GravityScale = ProjectileMovement->ProjectileGravityScale;
+}
+
+void AGSUTProjectile::RewindBallisticLaunch(float DeltaTime)
+{
+    if (UsesBallisticReplay() && GSUTProjLaunch.IsValid())
+    {
+        GSUTProjLaunch.ServerSpawnTime = FMath::Max(0.f, GSUTProjLaunch.ServerSpawnTime - DeltaTime);
+    }
+}
+
+void AGSUTProjectile::TickBallisticReplay()
+{
+    UGSUTProjectileMovementComponent* UTMovement = Cast<UGSUTProjectileMovementComponent>(ProjectileMovement);
+    if (UTMovement == NULL || UTMovement->UpdatedComponent == NULL)
+    {
+        StopBallisticReplay();
+        return;
+    }
+
+    const float ReplayTime = FMath::Max(0.f, GetBallisticReplayServerTime() - GSUTProjLaunch.ServerSpawnTime);
+
+    if (!bBallisticReplayIntegrating)
+    {
+        FVector NewLocation;
+        FVector NewVelocity;
+
+        if (UTMovement->EvaluateClosedFormTrajectory(GSUTProjLaunch.Origin, GSUTProjLaunch.Velocity, ReplayTime, NewLocation, NewVelocity))
+        {
+            const FQuat NewRotation = UTMovement->bRotationFollowsVelocity
+                ? NewVelocity.ToOrientationQuat()
+                : UTMovement->UpdatedComponent->GetComponentQuat();
+
+            UTMovement->Velocity = NewVelocity;
+
+            FHitResult Hit;
+            UTMovement->SafeMoveUpdatedComponent(NewLocation - GetActorLocation(), NewRotation, true, Hit);
+            if (Hit.bBlockingHit && !IsPendingKillPending())
+            {
+                UTMovement->SimulateImpact(Hit);
+            }
+
+            BallisticReplayTime = ReplayTime;
+            return;
+        }
+
+        // no closed-form solution from here on, continue from the current state with the integrator
+        bBallisticReplayIntegrating = true;
+    }
+
+    const float Step = FMath::Max(BallisticReplayStep, 0.001f);
+    while ((BallisticReplayTime + Step <= ReplayTime) && !bExploded && !IsPendingKillPending() && UTMovement->UpdatedComponent)
+    {
+        UTMovement->TickComponent(Step, LEVELTICK_All, NULL);
+        BallisticReplayTime += Step;
+    }
+}
+
+float AGSUTProjectile::GetBallisticReplayServerTime() const
+{
+    const AGameStateBase* GameState = GetWorld()->GetGameState();
+    float ServerTime = GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+
+    if (GetLocalRole() != ROLE_Authority)
+    {
+        AGSPlayerController* MyPlayer = Cast<AGSPlayerController>(GEngine->GetFirstLocalPlayerController(GetWorld()));
+        if (MyPlayer)
+        {
+            ServerTime += MyPlayer->GetPredictionTime();
+        }
+    }
+
+    return ServerTime;
+}
+
+void AGSUTProjectile::StopBallisticReplay()
+{
+    if (!bBallisticReplayActive)
+    {
+        return;
+    }
+
+    bBallisticReplayActive = false;
+    bBallisticReplayIntegrating = false;
+
+    if (ProjectileMovement)
+    {
+        ProjectileMovement->SetComponentTickEnabled(true);
+    }
+}
+
 void AGSUTProjectile::OnRep_Slomo()
 {
+    // time dilation changes the trajectory, fall back to regular movement
+    if (bBallisticReplayActive && (Slomo != 1.f))
+    {
+        StopBallisticReplay();
+    }
+
     CustomTimeDilation = Slomo;
     bForceNextRepMovement = true;
     if (Slomo != 1.f)
@@ -1002,36 +1221,15 @@ void AGSUTProjectile::Explode_Implementation(const FVector& HitLocation, const F
         bExploded = true;
 
         AGSUTProjectile* Proj = (MasterProjectile != NULL) ? MasterProjectile : this;
-        //float AdjustedMomentum = Momentum;
-        //FRadialDamageParams AdjustedDamageParams = Proj->GetDamageParams(NULL, HitLocation, AdjustedMomentum);
+        float AdjustedMomentum = Momentum;
+        FRadialDamageParams AdjustedDamageParams = Proj->GetDamageParams(NULL, HitLocation, AdjustedMomentum);
 
         if (!bFakeClientProjectile)
         {
-            //if (AdjustedDamageParams.OuterRadius > 0.0f)
-            //{
-            //    TArray<AActor*> IgnoreActors;
-            //    if (ImpactedActor != NULL)
-            //    {
-            //        IgnoreActors.Add(ImpactedActor);
-            //    }
-            //    TArray<FVector> AltOrigins;
-            //    AltOrigins.Add(HitLocation + HitNormal * GetDefault<AUTCharacter>()->UTCharacterMovement->MaxStepHeight);
-            //    if (!ProjectileMovement->Velocity.IsZero())
-            //    {
-            //        AltOrigins.Add(HitLocation - ProjectileMovement->Velocity.GetSafeNormal() * GetDefault<AUTCharacter>()->UTCharacterMovement->MaxStepHeight);
-            //    }
-            //    StatsHitCredit = 0.f;
-            //    UUTGameplayStatics::UTHurtRadius(this, AdjustedDamageParams.BaseDamage, AdjustedDamageParams.MinimumDamage, AdjustedMomentum, HitLocation + HitNormal, AdjustedDamageParams.InnerRadius, AdjustedDamageParams.OuterRadius, AdjustedDamageParams.DamageFalloff,
-            //        MyDamageType, IgnoreActors, this, InstigatorController, FFInstigatorController, FFDamageType, 0.0f, &AltOrigins);
-            //    if ((GetLocalRole() == ROLE_Authority) && (HitsStatsName != NAME_None))
-            //    {
-            //        AUTPlayerState* PS = InstigatorController ? Cast<AUTPlayerState>(InstigatorController->PlayerState) : NULL;
-            //        if (PS)
-            //        {
-            //            PS->ModifyStatsValue(HitsStatsName, StatsHitCredit / AdjustedDamageParams.BaseDamage);
-            //        }
-            //    }
-            //}
+            if ((AdjustedDamageParams.OuterRadius > 0.0f) && (GetLocalRole() == ROLE_Authority))
+            {
+                ApplyRadialDamage(HitLocation + HitNormal, HitNormal, AdjustedDamageParams);
+            }
             if (GetLocalRole() == ROLE_Authority)
             {
                 TearOff(); //bTearOff = true;
@@ -1053,6 +1251,147 @@ void AGSUTProjectile::Explode_Implementation(const FVector& HitLocation, const F
     }
 }
 
+int32 AGSUTProjectile::ApplyRadialDamage(const FVector& Origin, const FVector& HitNormal, const FRadialDamageParams& InDamageParams)
+{
+    QUICK_SCOPE_CYCLE_COUNTER(STAT_GSUTProjectile_ApplyRadialDamage);
+
+    if (! GameplayEffectSpecs.HasValidEffects())
+    {
+        return 0;
+    }
+
+    UWorld* World = GetWorld();
+    AActor* ProjInstigator = GetInstigator();
+
+    // Gather candidates from the physics scene with a single overlap query
+    FCollisionQueryParams OverlapParams(SCENE_QUERY_STAT(GSUTProjectileRadialOverlap), false, this);
+    if (ImpactedActor)
+    {
+        OverlapParams.AddIgnoredActor(ImpactedActor);
+    }
+    if (ProjInstigator && !bCanHitInstigator)
+    {
+        OverlapParams.AddIgnoredActor(ProjInstigator);
+    }
+
+    TArray<FOverlapResult> Overlaps;
+    World->OverlapMultiByObjectType(
+        Overlaps,
+        Origin,
+        FQuat::Identity,
+        FCollisionObjectQueryParams(ECC_Pawn),
+        FCollisionShape::MakeSphere(InDamageParams.OuterRadius),
+        OverlapParams
+        );
+
+    // Unique, living characters with their collision capsule
+    TArray<AGSCharacterBase*, TInlineAllocator<32>> Victims;
+    TArray<UPrimitiveComponent*, TInlineAllocator<32>> VictimComps;
+
+    for (const FOverlapResult& Overlap : Overlaps)
+    {
+        AGSCharacterBase* Character = Cast<AGSCharacterBase>(Overlap.GetActor());
+        if (Character && Character->IsAlive() && !Victims.Contains(Character))
+        {
+            Victims.Add(Character);
+            VictimComps.Add(Character->GetCapsuleComponent());
+        }
+    }
+
+    if (Victims.Num() == 0)
+    {
+        return 0;
+    }
+
+    // Alternate origins so that explosions against floors and walls still reach characters standing on / behind the edge
+    const float StepHeight = GetDefault<UCharacterMovementComponent>()->MaxStepHeight;
+    TArray<FVector, TInlineAllocator<3>> TraceOrigins;
+    TraceOrigins.Add(Origin);
+    TraceOrigins.Add(Origin + HitNormal * StepHeight);
+    if (!ProjectileMovement->Velocity.IsZero())
+    {
+        TraceOrigins.Add(Origin - ProjectileMovement->Velocity.GetSafeNormal() * StepHeight);
+    }
+
+    // Batched occlusion traces, one query params shared by all victims
+    FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(GSUTProjectileRadialOcclusion), false, this);
+    TArray<FHitResult> VictimHits;
+    VictimHits.Reserve(Victims.Num());
+
+    for (int32 i = 0; i < Victims.Num(); ++i)
+    {
+        AGSCharacterBase* Victim = Victims[i];
+        UPrimitiveComponent* VictimComp = VictimComps[i];
+        const FVector VictimLocation = Victim->GetActorLocation();
+
+        TraceParams.ClearIgnoredActors();
+        TraceParams.AddIgnoredActor(this);
+        TraceParams.AddIgnoredActor(Victim);
+
+        bool bVisible = false;
+        for (const FVector& TraceOrigin : TraceOrigins)
+        {
+            if (!World->LineTraceTestByChannel(TraceOrigin, VictimLocation, COLLISION_TRACE_WEAPON, TraceParams))
+            {
+                bVisible = true;
+                break;
+            }
+        }
+
+        if (!bVisible)
+        {
+            continue;
+        }
+
+        FVector ClosestPoint = VictimLocation;
+        float Distance = (VictimLocation - Origin).Size();
+        if (VictimComp && (VictimComp->GetClosestPointOnCollision(Origin, ClosestPoint) >= 0.f))
+        {
+            Distance = (ClosestPoint - Origin).Size();
+        }
+
+        // TraceStart and Distance are used by GSDamageExecutionCalc to scale radial damage
+        FHitResult& Hit = VictimHits.Emplace_GetRef(Victim, VictimComp, ClosestPoint, (ClosestPoint - Origin).GetSafeNormal());
+        Hit.TraceStart = Origin;
+        Hit.TraceEnd = VictimLocation;
+        Hit.Distance = Distance;
+    }
+
+    if (VictimHits.Num() == 0)
+    {
+        return 0;
+    }
+
+    // Copy the effect specs with this projectile as the effect causer so damage falloff can be resolved per victim
+    static const FGameplayTag RadialDamageTag = FGameplayTag::RequestGameplayTag(FName("Effect.Damage.Radial"));
+
+    FGSGameplayEffectContainerSpec RadialSpec;
+    RadialSpec.TargetGameplayEffectSpecs.Reserve(GameplayEffectSpecs.TargetGameplayEffectSpecs.Num());
+
+    for (const FGameplayEffectSpecHandle& SpecHandle : GameplayEffectSpecs.TargetGameplayEffectSpecs)
+    {
+        if (!SpecHandle.IsValid())
+        {
+            continue;
+        }
+
+        FGameplayEffectSpec* RadialEffectSpec = new FGameplayEffectSpec(*SpecHandle.Data.Get());
+        FGameplayEffectContextHandle RadialContext = RadialEffectSpec->GetContext().Duplicate();
+        RadialContext.AddInstigator(RadialContext.GetInstigator(), this);
+        RadialEffectSpec->SetContext(RadialContext, true);
+        RadialEffectSpec->DynamicAssetTags.AddTag(RadialDamageTag);
+
+        RadialSpec.TargetGameplayEffectSpecs.Add(FGameplayEffectSpecHandle(RadialEffectSpec));
+    }
+
+    RadialSpec.AddTargets(TArray<FGameplayAbilityTargetDataHandle>(), VictimHits, TArray<AActor*>());
+
+    // Projectiles have no ability instance, apply through the external container path in one pass
+    UGSBlueprintFunctionLibrary::ApplyExternalEffectContainerSpec(RadialSpec);
+
+    return VictimHits.Num();
+}
+
 void AGSUTProjectile::Destroyed()
 {
     if (MyFakeProjectile)
@@ -1196,3 +1535,675 @@ void AGSUTProjectile::PrepareForIntermission()
         }
     }
 }
+
+#if !UE_BUILD_SHIPPING
+
+static const int32 GSRecordedRepMovementVersion = 1;
+
+static FString GetRecordedRepMovementFile(const TArray<FString>& Args, int32 ArgIndex)
+{
+    return Args.IsValidIndex(ArgIndex) ? Args[ArgIndex] : FPaths::ProfilingDir() / TEXT("GSProjRepMovement.bin");
+}
+
+static bool LoadRecordedRepMovement(const FString& File)
+{
+    TArray<uint8> Data;
+    if (!FFileHelper::LoadFileToArray(Data, *File))
+    {
+        return false;
+    }
+
+    FMemoryReader Reader(Data);
+    int32 Version = 0;
+    Reader << Version;
+    if (Version != GSRecordedRepMovementVersion)
+    {
+        return false;
+    }
+
+    Reader << GGSRecordedRepMovement;
+    return !Reader.IsError();
+}
+
+// Records replicated projectile movement of a play session (e.g. a firefight) for GS.Projectile.BenchmarkRepMovement
+static void GSProjectileRecordRepMovement(const TArray<FString>& Args)
+{
+    const FString Action = Args.Num() > 0 ? Args[0] : FString();
+
+    if (Action == TEXT("Start"))
+    {
+        GGSRecordedRepMovement.Reset();
+        GGSRecordRepMovement = true;
+        UE_LOG(LogTemp, Log, TEXT("GS.Projectile.RecordRepMovement: recording"));
+    }
+    else if (Action == TEXT("Stop"))
+    {
+        GGSRecordRepMovement = false;
+        UE_LOG(LogTemp, Log, TEXT("GS.Projectile.RecordRepMovement: recorded %d movement updates"), GGSRecordedRepMovement.Num());
+    }
+    else if (Action == TEXT("Save"))
+    {
+        const FString File = GetRecordedRepMovementFile(Args, 1);
+
+        TArray<uint8> Data;
+        FMemoryWriter Writer(Data);
+        int32 Version = GSRecordedRepMovementVersion;
+        Writer << Version;
+        Writer << GGSRecordedRepMovement;
+
+        if (FFileHelper::SaveArrayToFile(Data, *File))
+        {
+            UE_LOG(LogTemp, Log, TEXT("GS.Projectile.RecordRepMovement: saved %d movement updates to %s"), GGSRecordedRepMovement.Num(), *File);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Error, TEXT("GS.Projectile.RecordRepMovement: failed to save %s"), *File);
+        }
+    }
+    else if (Action == TEXT("Load"))
+    {
+        const FString File = GetRecordedRepMovementFile(Args, 1);
+
+        if (LoadRecordedRepMovement(File))
+        {
+            UE_LOG(LogTemp, Log, TEXT("GS.Projectile.RecordRepMovement: loaded %d movement updates from %s"), GGSRecordedRepMovement.Num(), *File);
+        }
+        else
+        {
+            GGSRecordedRepMovement.Reset();
+            UE_LOG(LogTemp, Error, TEXT("GS.Projectile.RecordRepMovement: failed to load %s"), *File);
+        }
+    }
+    else
+    {
+        UE_LOG(LogTemp, Log, TEXT("GS.Projectile.RecordRepMovement: %s, %d movement updates recorded"),
+            GGSRecordRepMovement ? TEXT("recording") : TEXT("stopped"),
+            GGSRecordedRepMovement.Num()
+            );
+    }
+}
+
+static FAutoConsoleCommand GSProjectileRecordRepMovementCommand(
+    TEXT("GS.Projectile.RecordRepMovement"),
+    TEXT("Records the movement of server projectiles at every net update for GS.Projectile.BenchmarkRepMovement. Arguments: Start | Stop | Save [File] | Load [File]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&GSProjectileRecordRepMovement)
+    );
+
+// Measures the replicated size of FRepGSUTProjMovement per quantization mode over the recorded firefight
+// and checks the compressed round trip of every recorded update
+static void GSProjectileBenchmarkRepMovement(const TArray<FString>& Args)
+{
+    if (Args.Num() > 0 || GGSRecordedRepMovement.Num() == 0)
+    {
+        const FString File = GetRecordedRepMovementFile(Args, 0);
+        if (!LoadRecordedRepMovement(File))
+        {
+            GGSRecordedRepMovement.Reset();
+            UE_LOG(LogTemp, Error, TEXT("GS.Projectile.BenchmarkRepMovement: FAILED, no recorded firefight in %s, record one with GS.Projectile.RecordRepMovement"), *File);
+            return;
+        }
+    }
+
+    // FVector_NetQuantize and the speed round to whole units, 16-bit pitch/yaw direction,
+    // rotation of stopped projectiles is sent with FRotator::SerializeCompressed (8 bits per axis)
+    const float MaxLocationError = 1.f;
+    const float MaxSpeedError = 1.f;
+    const float MaxDirectionError = 0.001f;
+    const float MaxRotationError = 360.f / 256.f;
+
+    auto SerializeBits = [](FRepGSUTProjMovement& Movement)
+    {
+        FNetBitWriter Writer(nullptr, 1024);
+        bool bSuccess = true;
+        Movement.NetSerialize(Writer, nullptr, bSuccess);
+        return Writer.GetNumBits();
+    };
+
+    auto MakeMovement = [](const FGSRecordedProjMovement& Sample, EGSProjMovementQuantization Quantization)
+    {
+        FRepGSUTProjMovement Movement;
+        Movement.Location = Sample.Location;
+        Movement.Rotation = Sample.Rotation;
+        Movement.LinearVelocity = Sample.LinearVelocity;
+        Movement.Quantization = Quantization;
+        Movement.bRotationFromVelocity = (Quantization != EGSProjMovementQuantization::Default) && Sample.bRotationFollowsVelocity;
+        return Movement;
+    };
+
+    // First and last recorded update of every projectile
+    TMap<uint32, TPair<int32, int32>> Projectiles;
+
+    const int32 NumSamples = GGSRecordedRepMovement.Num();
+    int64 DefaultTotalBits = 0;
+    int64 CompressedTotalBits = 0;
+    int32 NumRoundTripFailures = 0;
+
+    for (int32 i = 0; i < NumSamples; ++i)
+    {
+        const FGSRecordedProjMovement& Sample = GGSRecordedRepMovement[i];
+
+        TPair<int32, int32>* Projectile = Projectiles.Find(Sample.ProjectileId);
+        if (Projectile)
+        {
+            Projectile->Value = i;
+        }
+        else
+        {
+            Projectiles.Add(Sample.ProjectileId, TPair<int32, int32>(i, i));
+        }
+
+        FRepGSUTProjMovement DefaultMovement = MakeMovement(Sample, EGSProjMovementQuantization::Default);
+        DefaultTotalBits += SerializeBits(DefaultMovement);
+
+        FRepGSUTProjMovement Movement = MakeMovement(Sample, EGSProjMovementQuantization::Compressed);
+
+        FNetBitWriter Writer(nullptr, 1024);
+        bool bSuccess = true;
+        Movement.NetSerialize(Writer, nullptr, bSuccess);
+        CompressedTotalBits += Writer.GetNumBits();
+
+        FNetBitReader Reader(nullptr, Writer.GetData(), Writer.GetNumBits());
+        FRepGSUTProjMovement Received;
+        Received.NetSerialize(Reader, nullptr, bSuccess);
+
+        const float Speed = Sample.LinearVelocity.Size();
+        const FRotator ExpectedRotation = (Sample.bRotationFollowsVelocity && Speed > 0.f) ? Sample.LinearVelocity.Rotation() : Sample.Rotation;
+
+        const bool bValid = bSuccess
+            && Received.Location.Equals(Sample.Location, MaxLocationError)
+            && FMath::IsNearlyEqual(Received.LinearVelocity.Size(), Speed, MaxSpeedError)
+            && ((Speed <= 0.f) || (Received.LinearVelocity.GetSafeNormal() | Sample.LinearVelocity.GetSafeNormal()) >= 1.f - MaxDirectionError)
+            && Received.Rotation.Equals(ExpectedRotation, MaxRotationError);
+
+        if (!bValid)
+        {
+            ++NumRoundTripFailures;
+        }
+    }
+
+    // Ballistic replay sends the launch state once (FRepGSUTProjLaunch replicates property by property) and the compressed final state
+    int64 BallisticTotalBits = 0;
+    for (const TPair<uint32, TPair<int32, int32>>& Projectile : Projectiles)
+    {
+        const FGSRecordedProjMovement& Launch = GGSRecordedRepMovement[Projectile.Value.Key];
+
+        FNetBitWriter LaunchWriter(nullptr, 1024);
+        bool bSuccess = true;
+        FVector_NetQuantize Origin(Launch.Location);
+        FVector_NetQuantize10 Velocity(Launch.LinearVelocity);
+        Origin.NetSerialize(LaunchWriter, nullptr, bSuccess);
+        Velocity.NetSerialize(LaunchWriter, nullptr, bSuccess);
+        BallisticTotalBits += LaunchWriter.GetNumBits() + 2 * 32;
+
+        FRepGSUTProjMovement Final = MakeMovement(GGSRecordedRepMovement[Projectile.Value.Value], EGSProjMovementQuantization::BallisticReplay);
+        BallisticTotalBits += SerializeBits(Final);
+    }
+
+    const int32 NumProjectiles = Projectiles.Num();
+    const double DefaultBits = static_cast<double>(DefaultTotalBits) / NumSamples;
+    const double CompressedBits = static_cast<double>(CompressedTotalBits) / NumSamples;
+
+    UE_LOG(LogTemp, Log, TEXT("GS.Projectile.BenchmarkRepMovement: %d projectiles, %d movement updates (%.1f per projectile)"),
+        NumProjectiles,
+        NumSamples,
+        static_cast<double>(NumSamples) / NumProjectiles
+        );
+    UE_LOG(LogTemp, Log, TEXT("  Default: %.1f bits/update, %.0f bits/projectile"), DefaultBits, static_cast<double>(DefaultTotalBits) / NumProjectiles);
+    UE_LOG(LogTemp, Log, TEXT("  Compressed: %.1f bits/update, %.0f bits/projectile (%.0f%% of default)"),
+        CompressedBits,
+        static_cast<double>(CompressedTotalBits) / NumProjectiles,
+        100.0 * CompressedTotalBits / FMath::Max<int64>(DefaultTotalBits, 1)
+        );
+    UE_LOG(LogTemp, Log, TEXT("  BallisticReplay: %.0f bits/projectile (%.0f%% of default)"),
+        static_cast<double>(BallisticTotalBits) / NumProjectiles,
+        100.0 * BallisticTotalBits / FMath::Max<int64>(DefaultTotalBits, 1)
+        );
+
+    bool bPassed = true;
+
+    if (NumRoundTripFailures > 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("GS.Projectile.BenchmarkRepMovement: FAILED, %d of %d compressed round trips out of tolerance"), NumRoundTripFailures, NumSamples);
+        bPassed = false;
+    }
+
+    if (CompressedBits >= DefaultBits)
+    {
+        UE_LOG(LogTemp, Error, TEXT("GS.Projectile.BenchmarkRepMovement: FAILED, compressed updates (%.1f bits) are not smaller than default updates (%.1f bits)"), CompressedBits, DefaultBits);
+        bPassed = false;
+    }
+
+    if (bPassed)
+    {
+        UE_LOG(LogTemp, Log, TEXT("GS.Projectile.BenchmarkRepMovement: passed"));
+    }
+}
+
+static FAutoConsoleCommand GSProjectileBenchmarkRepMovementCommand(
+    TEXT("GS.Projectile.BenchmarkRepMovement"),
+    TEXT("Measures replicated projectile movement size per quantization mode over the movement recorded with GS.Projectile.RecordRepMovement and checks the compressed round trip. Arguments: [File]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&GSProjectileBenchmarkRepMovement)
+    );
+
+// Stress test of ApplyRadialDamage, NumExplosions in one frame inside a crowd of NumCharacters heroes.
+// Every explosion must apply its damage effect to at least the characters whose center is in range and visible
+// from the origin and at most the characters whose capsule is in range, counted by the characters' ability systems.
+static void GSProjectileStressRadialDamage(const TArray<FString>& Args, UWorld* World)
+{
+    const int32 NumExplosions = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 50;
+    const int32 NumCharacters = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 64;
+
+    if (! World || World->GetNetMode() == NM_Client)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("GS.Projectile.StressRadialDamage: Needs an authoritative world"));
+        return;
+    }
+
+    AGSHeroCharacter* Template = nullptr;
+    for (TActorIterator<AGSHeroCharacter> It(World); It; ++It)
+    {
+        if (It->GetAbilitySystemComponent())
+        {
+            Template = *It;
+            break;
+        }
+    }
+
+    if (! Template)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("GS.Projectile.StressRadialDamage: No hero with an ability system in the world"));
+        return;
+    }
+
+    // Zero magnitude damage so the crowd survives every explosion and the expected victims stay the same
+    UGameplayEffect* DamageEffect = NewObject<UGameplayEffect>(GetTransientPackage());
+    DamageEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
+
+    FGameplayModifierInfo DamageModifier;
+    DamageModifier.Attribute = UGSAttributeSetBase::GetDamageAttribute();
+    DamageModifier.ModifierOp = EGameplayModOp::Additive;
+    DamageModifier.ModifierMagnitude = FScalableFloat(0.f);
+    DamageEffect->Modifiers.Add(DamageModifier);
+
+    UAbilitySystemComponent* TemplateASC = Template->GetAbilitySystemComponent();
+    FGameplayEffectSpecHandle DamageSpec(new FGameplayEffectSpec(DamageEffect, TemplateASC->MakeEffectContext(), 1.f));
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+    // The projectile is spawned away from the crowd before it exists so it never overlaps a character
+    const float Spacing = 200.f;
+    const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumCharacters)));
+    const FVector Center = Template->GetActorLocation() + Template->GetActorForwardVector() * (Spacing * (GridSize + 2) * 0.5f);
+
+    AGSUTProjectile* Projectile = World->SpawnActor<AGSUTProjectile>(AGSUTProjectile::StaticClass(), Center + FVector(0.f, 0.f, 50000.f), FRotator::ZeroRotator, SpawnParams);
+    if (! Projectile)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("GS.Projectile.StressRadialDamage: Failed to spawn a projectile"));
+        return;
+    }
+
+    Projectile->ProjectileMovement->StopMovementImmediately();
+    Projectile->GameplayEffectSpecs.TargetGameplayEffectSpecs.Add(DamageSpec);
+
+    TArray<AGSHeroCharacter*> Crowd;
+    Crowd.Reserve(NumCharacters);
+
+    for (int32 i = 0; i < NumCharacters; ++i)
+    {
+        const FVector Offset((i % GridSize - (GridSize - 1) * 0.5f) * Spacing, (i / GridSize - (GridSize - 1) * 0.5f) * Spacing, 0.f);
+        AGSHeroCharacter* Character = World->SpawnActor<AGSHeroCharacter>(Template->GetClass(), Center + Offset, Template->GetActorRotation(), SpawnParams);
+
+        if (Character)
+        {
+            Character->SpawnDefaultController();
+            Crowd.Add(Character);
+        }
+    }
+
+    // Applications of the damage effect, counted where the effect lands instead of trusting the gathered victims
+    int32 NumApplied = 0;
+    TArray<TPair<UAbilitySystemComponent*, FDelegateHandle>> AppliedDelegates;
+
+    TArray<AGSCharacterBase*> Characters;
+    for (TActorIterator<AGSCharacterBase> It(World); It; ++It)
+    {
+        UAbilitySystemComponent* ASC = It->GetAbilitySystemComponent();
+        if (It->IsAlive() && ASC)
+        {
+            Characters.Add(*It);
+
+            const FDelegateHandle Handle = ASC->OnGameplayEffectAppliedDelegateToSelf.AddLambda(
+                [DamageEffect, &NumApplied](UAbilitySystemComponent* Target, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle ActiveHandle)
+                {
+                    if (Spec.Def == DamageEffect)
+                    {
+                        ++NumApplied;
+                    }
+                });
+            AppliedDelegates.Add(TPair<UAbilitySystemComponent*, FDelegateHandle>(ASC, Handle));
+        }
+    }
+
+    FRadialDamageParams DamageParams = Projectile->DamageParams;
+    DamageParams.OuterRadius = FMath::Max(DamageParams.OuterRadius, Spacing * 2.f);
+
+    FRandomStream RandomStream(NumExplosions);
+    FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(GSStressRadialDamage), false, Projectile);
+
+    int32 NumFailures = 0;
+    int32 NumUnappliedVictims = 0;
+    int64 TotalVictims = 0;
+    double TotalTime = 0.0;
+    double MaxTime = 0.0;
+
+    for (int32 Explosion = 0; Explosion < NumExplosions; ++Explosion)
+    {
+        const float HalfExtent = Spacing * GridSize * 0.5f;
+        const FVector Origin = Center + FVector(RandomStream.FRandRange(-HalfExtent, HalfExtent), RandomStream.FRandRange(-HalfExtent, HalfExtent), 0.f);
+
+        int32 MinVictims = 0;
+        int32 MaxVictims = 0;
+
+        for (AGSCharacterBase* Character : Characters)
+        {
+            const FVector Location = Character->GetActorLocation();
+
+            FVector ClosestPoint = Location;
+            if (Character->GetCapsuleComponent()->GetClosestPointOnCollision(Origin, ClosestPoint) < 0.f)
+            {
+                ClosestPoint = Location;
+            }
+
+            if ((ClosestPoint - Origin).Size() <= DamageParams.OuterRadius + 1.f)
+            {
+                ++MaxVictims;
+            }
+
+            TraceParams.ClearIgnoredActors();
+            TraceParams.AddIgnoredActor(Projectile);
+            TraceParams.AddIgnoredActor(Character);
+
+            if ((Location - Origin).Size() <= DamageParams.OuterRadius
+                && !World->LineTraceTestByChannel(Origin, Location, COLLISION_TRACE_WEAPON, TraceParams))
+            {
+                ++MinVictims;
+            }
+        }
+
+        NumApplied = 0;
+
+        const double StartTime = FPlatformTime::Seconds();
+        const int32 NumVictims = Projectile->ApplyRadialDamage(Origin, FVector::UpVector, DamageParams);
+        const double Time = FPlatformTime::Seconds() - StartTime;
+
+        TotalTime += Time;
+        MaxTime = FMath::Max(MaxTime, Time);
+        TotalVictims += NumApplied;
+
+        if (NumApplied < MinVictims || NumApplied > MaxVictims)
+        {
+            ++NumFailures;
+            UE_LOG(LogTemp, Warning, TEXT("  Explosion %d at %s damaged %d characters, expected %d to %d"), Explosion, *Origin.ToString(), NumApplied, MinVictims, MaxVictims);
+        }
+
+        if (NumApplied != NumVictims)
+        {
+            ++NumUnappliedVictims;
+            UE_LOG(LogTemp, Warning, TEXT("  Explosion %d at %s gathered %d victims but applied damage %d times"), Explosion, *Origin.ToString(), NumVictims, NumApplied);
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("GS.Projectile.StressRadialDamage: %d explosions, %d characters (%d spawned), radius %.0f"),
+        NumExplosions,
+        Characters.Num(),
+        Crowd.Num(),
+        DamageParams.OuterRadius
+        );
+    UE_LOG(LogTemp, Log, TEXT("  %.3f ms total, %.3f ms/explosion average, %.3f ms max, %.1f victims/explosion"),
+        TotalTime * 1000.0,
+        TotalTime * 1000.0 / NumExplosions,
+        MaxTime * 1000.0,
+        static_cast<double>(TotalVictims) / NumExplosions
+        );
+
+    if (NumFailures > 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("GS.Projectile.StressRadialDamage: FAILED, %d explosions damaged an unexpected number of characters"), NumFailures);
+    }
+
+    if (NumUnappliedVictims > 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("GS.Projectile.StressRadialDamage: FAILED, %d explosions did not apply damage to every gathered victim"), NumUnappliedVictims);
+    }
+
+    if (NumFailures == 0 && NumUnappliedVictims == 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("GS.Projectile.StressRadialDamage: passed"));
+    }
+
+    for (const TPair<UAbilitySystemComponent*, FDelegateHandle>& AppliedDelegate : AppliedDelegates)
+    {
+        AppliedDelegate.Key->OnGameplayEffectAppliedDelegateToSelf.Remove(AppliedDelegate.Value);
+    }
+
+    for (AGSHeroCharacter* Character : Crowd)
+    {
+        if (AController* Controller = Character->GetController())
+        {
+            Controller->Destroy();
+        }
+        Character->Destroy();
+    }
+
+    Projectile->Destroy();
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GSProjectileStressRadialDamageCommand(
+    TEXT("GS.Projectile.StressRadialDamage"),
+    TEXT("Explodes projectiles inside a crowd of spawned heroes in one frame and checks the damaged characters of every explosion. Arguments: [NumExplosions] [NumCharacters]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&GSProjectileStressRadialDamage)
+    );
+
+// Checks that CatchupTick lands on the same endpoint regardless of MaxCatchupStep,
+// against the closed-form trajectory for straight, ballistic and accelerating projectiles
+static void GSProjectileCheckCatchupTick(const TArray<FString>& Args, UWorld* World)
+{
+    const float CatchupTime = Args.Num() > 0 ? FMath::Max(0.01f, FCString::Atof(*Args[0])) : 0.5f;
+    const float LaunchSpeed = Args.Num() > 1 ? FMath::Max(1.f, FCString::Atof(*Args[1])) : 5000.f;
+
+    if (! World)
+    {
+        return;
+    }
+
+    struct FCatchupScenario
+    {
+        const TCHAR* Name;
+        float GravityScale;
+        float AccelRate;
+        float MaxSpeed;
+    };
+
+    const FCatchupScenario Scenarios[] =
+    {
+        { TEXT("Straight"), 0.f, 0.f, 0.f },
+        { TEXT("Ballistic"), 1.f, 0.f, 0.f },
+        { TEXT("Accelerating"), 0.f, 2000.f, LaunchSpeed * 1.5f },
+    };
+
+    // The last step does not divide CatchupTime so the remainder folding is covered as well
+    const float Steps[] = { CatchupTime, 1.f / 15.f, 1.f / 30.f, 1.f / 60.f, 1.f / 120.f, 0.07f };
+
+    // Launched high above the map so nothing is in the way
+    FVector Origin = FVector(0.f, 0.f, 100000.f);
+    if (APlayerController* PC = World->GetFirstPlayerController())
+    {
+        if (PC->GetPawn())
+        {
+            Origin += PC->GetPawn()->GetActorLocation();
+        }
+    }
+
+    const FVector LaunchVelocity = FVector(LaunchSpeed, 0.f, 0.f);
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    int32 NumFailures = 0;
+
+    for (const FCatchupScenario& Scenario : Scenarios)
+    {
+        for (const float Step : Steps)
+        {
+            AGSUTProjectile* Projectile = World->SpawnActor<AGSUTProjectile>(AGSUTProjectile::StaticClass(), Origin, FRotator::ZeroRotator, SpawnParams);
+            UGSUTProjectileMovementComponent* Movement = Projectile ? Cast<UGSUTProjectileMovementComponent>(Projectile->ProjectileMovement) : nullptr;
+
+            if (! Movement)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("GS.Projectile.CheckCatchupTick: Failed to spawn a projectile"));
+                if (Projectile)
+                {
+                    Projectile->Destroy();
+                }
+                return;
+            }
+
+            Projectile->SetActorLocation(Origin);
+            Movement->ProjectileGravityScale = Scenario.GravityScale;
+            Movement->AccelRate = Scenario.AccelRate;
+            Movement->MaxSpeed = Scenario.MaxSpeed;
+            Movement->Acceleration = FVector::ZeroVector;
+            Movement->bShouldBounce = false;
+            Movement->bIsHomingProjectile = false;
+            Movement->MaxCatchupStep = Step;
+            Movement->Velocity = LaunchVelocity;
+
+            FVector ExpectedLocation;
+            FVector ExpectedVelocity;
+            const bool bHasClosedForm = Movement->EvaluateClosedFormTrajectory(Origin, LaunchVelocity, CatchupTime, ExpectedLocation, ExpectedVelocity);
+
+            const float SimulatedTime = Movement->CatchupTick(CatchupTime);
+            const FVector EndLocation = Projectile->GetActorLocation();
+
+            // Constant acceleration is integrated exactly, AccelRate only changes the velocity after each move
+            // so the location lags behind by up to half a step of acceleration
+            const float Tolerance = 1.f + 0.5f * FMath::Abs(Scenario.AccelRate) * FMath::Min(Step, CatchupTime) * CatchupTime;
+            const float Error = bHasClosedForm ? (EndLocation - ExpectedLocation).Size() : 0.f;
+
+            const bool bValid = bHasClosedForm
+                && FMath::IsNearlyEqual(SimulatedTime, CatchupTime, KINDA_SMALL_NUMBER)
+                && Error <= Tolerance;
+
+            UE_LOG(LogTemp, Log, TEXT("  %s, step %.4f: simulated %.4f s, error %.2f (tolerance %.2f)"),
+                Scenario.Name,
+                Step,
+                SimulatedTime,
+                Error,
+                Tolerance
+                );
+
+            if (!bValid)
+            {
+                ++NumFailures;
+                UE_LOG(LogTemp, Warning, TEXT("  %s, step %.4f: ended at %s, expected %s"), Scenario.Name, Step, *EndLocation.ToString(), *ExpectedLocation.ToString());
+            }
+
+            Projectile->Destroy();
+        }
+    }
+
+    // A pawn halfway along the path has to be hit at the step that reaches it, the catch-up stops there
+    AGSCharacterBase* PawnTemplate = nullptr;
+    for (TActorIterator<AGSCharacterBase> It(World); It; ++It)
+    {
+        PawnTemplate = *It;
+        break;
+    }
+
+    int32 NumPawnFailures = 0;
+
+    if (! PawnTemplate)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("GS.Projectile.CheckCatchupTick: No character in the world, skipping the pawn in the path"));
+    }
+    else
+    {
+        const float PawnDistance = LaunchSpeed * CatchupTime * 0.5f;
+        AGSCharacterBase* Pawn = World->SpawnActor<AGSCharacterBase>(PawnTemplate->GetClass(), Origin + FVector(PawnDistance, 0.f, 0.f), FRotator::ZeroRotator, SpawnParams);
+
+        for (const float Step : Steps)
+        {
+            AGSUTProjectile* Projectile = Pawn ? World->SpawnActor<AGSUTProjectile>(AGSUTProjectile::StaticClass(), Origin, FRotator::ZeroRotator, SpawnParams) : nullptr;
+            UGSUTProjectileMovementComponent* Movement = Projectile ? Cast<UGSUTProjectileMovementComponent>(Projectile->ProjectileMovement) : nullptr;
+
+            if (! Movement)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("GS.Projectile.CheckCatchupTick: Failed to spawn the pawn or a projectile"));
+                ++NumPawnFailures;
+                if (Projectile)
+                {
+                    Projectile->Destroy();
+                }
+                break;
+            }
+
+            Projectile->SetActorLocation(Origin);
+            Movement->ProjectileGravityScale = 0.f;
+            Movement->AccelRate = 0.f;
+            Movement->MaxSpeed = 0.f;
+            Movement->Acceleration = FVector::ZeroVector;
+            Movement->bShouldBounce = false;
+            Movement->bIsHomingProjectile = false;
+            Movement->MaxCatchupStep = Step;
+            Movement->Velocity = LaunchVelocity;
+
+            const float SimulatedTime = Movement->CatchupTick(CatchupTime);
+            const float Travelled = Projectile->GetActorLocation().X - Origin.X;
+
+            // The overlap fires after the move that reached the pawn, which is at most one movement sub-step long
+            const float MaxTravelled = PawnDistance + LaunchSpeed * FMath::Min(Step, Movement->MaxSimulationTimeStep);
+
+            const bool bValid = Projectile->bExploded
+                && SimulatedTime < CatchupTime
+                && Travelled <= MaxTravelled;
+
+            UE_LOG(LogTemp, Log, TEXT("  Pawn in the path, step %.4f: exploded %d after %.4f s, travelled %.0f (max %.0f)"),
+                Step,
+                int32(Projectile->bExploded),
+                SimulatedTime,
+                Travelled,
+                MaxTravelled
+                );
+
+            if (!bValid)
+            {
+                ++NumPawnFailures;
+            }
+
+            Projectile->Destroy();
+        }
+
+        if (Pawn)
+        {
+            Pawn->Destroy();
+        }
+    }
+
+    if (NumFailures > 0 || NumPawnFailures > 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("GS.Projectile.CheckCatchupTick: FAILED, %d endpoints out of tolerance, %d catch-ups passed through the pawn"), NumFailures, NumPawnFailures);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Log, TEXT("GS.Projectile.CheckCatchupTick: passed"));
+    }
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GSProjectileCheckCatchupTickCommand(
+    TEXT("GS.Projectile.CheckCatchupTick"),
+    TEXT("Compares CatchupTick endpoints across catch-up step sizes with the closed-form trajectory and checks a pawn in the path is hit. Arguments: [CatchupTime] [LaunchSpeed]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&GSProjectileCheckCatchupTick)
+    );
+
+#endif // !UE_BUILD_SHIPPING
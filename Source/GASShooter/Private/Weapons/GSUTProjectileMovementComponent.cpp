@@ -8,6 +8,41 @@ UGSUTProjectileMovementComponent::UGSUTProjectileMovementComponent(const FObject
 {
     HitZStopSimulatingThreshold = -1.1f; // default is always stop
     bPreventZHoming = false;
+    MaxCatchupStep = 1.f / 60.f;
+}
+
+float UGSUTProjectileMovementComponent::CatchupTick(float DeltaTime)
+{
+    if (DeltaTime <= 0.f || HasStoppedSimulation())
+    {
+        return 0.f;
+    }
+
+    AActor* ActorOwner = GetOwner();
+    const float Step = FMath::Max(MaxCatchupStep, 0.001f);
+    float SimulatedTime = 0.f;
+
+    // no deferred movement scope here: pawn hits come from overlap events, which have to fire
+    // at the step that reached the pawn so the projectile stops there instead of passing through
+    while (SimulatedTime < DeltaTime)
+    {
+        // fold a tiny remainder into the last step instead of ticking a near zero step
+        float StepTime = FMath::Min(Step, DeltaTime - SimulatedTime);
+        if ((DeltaTime - SimulatedTime - StepTime) < KINDA_SMALL_NUMBER)
+        {
+            StepTime = DeltaTime - SimulatedTime;
+        }
+
+        TickComponent(StepTime, LEVELTICK_All, NULL);
+        SimulatedTime += StepTime;
+
+        if (HasStoppedSimulation() || (ActorOwner && ActorOwner->IsPendingKillPending()))
+        {
+            break;
+        }
+    }
+
+    return SimulatedTime;
 }
 
 void UGSUTProjectileMovementComponent::InitializeComponent()
@@ -282,3 +317,78 @@ FVector UGSUTProjectileMovementComponent::ComputeHomingAcceleration(const FVecto
     }
     return HomingAcceleration;
 }
+
+bool UGSUTProjectileMovementComponent::HasClosedFormTrajectory() const
+{
+    if (bShouldBounce || bIsHomingProjectile || !Acceleration.IsZero())
+    {
+        return false;
+    }
+
+    // gravity combined with acceleration along velocity must be integrated
+    return (AccelRate == 0.f) || (GetGravityZ() == 0.f);
+}
+
+bool UGSUTProjectileMovementComponent::EvaluateClosedFormTrajectory(const FVector& Origin, const FVector& InitialVelocity, float Time, FVector& OutLocation, FVector& OutVelocity) const
+{
+    if (!HasClosedFormTrajectory())
+    {
+        return false;
+    }
+
+    Time = FMath::Max(Time, 0.f);
+
+    const float GravityZ = GetGravityZ();
+    const float SpeedLimit = (MaxSpeed > 0.f) ? MaxSpeed : BIG_NUMBER;
+
+    if (GravityZ != 0.f)
+    {
+        // constant acceleration, only valid while unclamped by MaxSpeed.
+        // speed is convex over time so checking both ends is enough.
+        OutVelocity = InitialVelocity + FVector(0.f, 0.f, GravityZ * Time);
+        if (InitialVelocity.SizeSquared() > FMath::Square(SpeedLimit) || OutVelocity.SizeSquared() > FMath::Square(SpeedLimit))
+        {
+            return false;
+        }
+
+        OutLocation = Origin + InitialVelocity * Time + FVector(0.f, 0.f, 0.5f * GravityZ * FMath::Square(Time));
+        return true;
+    }
+
+    const FVector Dir = InitialVelocity.GetSafeNormal();
+    const float InitialSpeed = FMath::Min(InitialVelocity.Size(), SpeedLimit);
+
+    if (AccelRate == 0.f)
+    {
+        OutVelocity = Dir * InitialSpeed;
+        OutLocation = Origin + OutVelocity * Time;
+        return true;
+    }
+
+    if (AccelRate < 0.f)
+    {
+        // deceleration reverses direction once speed reaches zero, leave that to the integrator
+        if (InitialSpeed + AccelRate * Time < 0.f)
+        {
+            return false;
+        }
+
+        OutVelocity = Dir * (InitialSpeed + AccelRate * Time);
+        OutLocation = Origin + Dir * (InitialSpeed * Time + 0.5f * AccelRate * FMath::Square(Time));
+        return true;
+    }
+
+    // accelerate along the initial direction until max speed is reached (see AGSUTProjectile::StaticGetTimeToLocation)
+    const float AccelTime = (SpeedLimit - InitialSpeed) / AccelRate;
+    if (Time <= AccelTime)
+    {
+        OutVelocity = Dir * (InitialSpeed + AccelRate * Time);
+        OutLocation = Origin + Dir * (InitialSpeed * Time + 0.5f * AccelRate * FMath::Square(Time));
+        return true;
+    }
+
+    const float AccelDist = InitialSpeed * AccelTime + 0.5f * AccelRate * FMath::Square(AccelTime);
+    OutVelocity = Dir * SpeedLimit;
+    OutLocation = Origin + Dir * (AccelDist + SpeedLimit * (Time - AccelTime));
+    return true;
+}
@@ -41,6 +41,10 @@ AGSWeapon::AGSWeapon()
 
     FireRate = 0.1f;
 
+    MaxDelayedProjectiles = 16;
+    DelayedProjectileHead = 0;
+    DelayedProjectileCount = 0;
+
     CollisionComp = CreateDefaultSubobject<UCapsuleComponent>(FName("CollisionComponent"));
     CollisionComp->InitCapsuleSize(40.0f, 50.0f);
     CollisionComp->SetCollisionObjectType(COLLISION_PICKUP);
@@ -391,6 +395,11 @@ void AGSWeapon::BeginPlay()
 {
     ResetWeapon();
 
+    // Allocate delayed projectile storage once, entries are reused afterwards
+    DelayedProjectiles.SetNum(FMath::Max(1, MaxDelayedProjectiles));
+    DelayedProjectileHead = 0;
+    DelayedProjectileCount = 0;
+
     if (!OwningCharacter && bSpawnWithCollision)
     {
         // Spawned into the world without an owner, enable collision as we are in pickup mode
@@ -412,6 +421,9 @@ void AGSWeapon::EndPlay(EEndPlayReason::Type EndPlayReason)
         SphereTraceTargetActor->Destroy();
     }
 
+    GetWorldTimerManager().ClearTimer(SpawnDelayedFakeProjHandle);
+    DelayedProjectileCount = 0;
+
     Super::EndPlay(EndPlayReason);
 }
 
@@ -513,19 +525,12 @@ FGSProjectileSpawnInfo AGSWeapon::SpawnNetPredictedProjectile(
         if (SleepTime > 0.f)
         {
             // lag is so high need to delay spawn
-            if (! GetWorldTimerManager().IsTimerActive(SpawnDelayedFakeProjHandle))
-            {
-                DelayedProjectile.ProjectileClass = ProjectileClass;
-                DelayedProjectile.SpawnLocation = SpawnLocation;
-                DelayedProjectile.SpawnRotation = SpawnRotation;
-                GetWorldTimerManager().SetTimer(
-                    SpawnDelayedFakeProjHandle,
-                    this,
-                    &AGSWeapon::SpawnDelayedFakeProjectile,
-                    SleepTime,
-                    false
-                    );
-            }
+            QueueDelayedFakeProjectile(
+                ProjectileClass,
+                SpawnLocation,
+                SpawnRotation,
+                SleepTime
+                );
 
             return FGSProjectileSpawnInfo(
                 nullptr,
@@ -601,7 +606,110 @@ FGSProjectileSpawnInfo AGSWeapon::SpawnNetPredictedProjectile(
         );
 }
 
-void AGSWeapon::SpawnDelayedFakeProjectile()
+void AGSWeapon::QueueDelayedFakeProjectile(
+    TSubclassOf<AGSUTProjectile> ProjectileClass,
+    FVector SpawnLocation,
+    FRotator SpawnRotation,
+    float SleepTime
+    )
+{
+    const int32 Capacity = DelayedProjectiles.Num();
+
+    if (Capacity <= 0)
+    {
+        return;
+    }
+
+    const float CurrentTime = GetWorld()->GetTimeSeconds();
+    const float SpawnTime = CurrentTime + SleepTime;
+
+    FGSDelayedProjectileInfo NewDelayedProjectile;
+    NewDelayedProjectile.ProjectileClass = ProjectileClass;
+    NewDelayedProjectile.SpawnLocation = SpawnLocation;
+    NewDelayedProjectile.SpawnRotation = SpawnRotation;
+    NewDelayedProjectile.SpawnTime = SpawnTime;
+
+    // Ring buffer full, spawn whichever entry is due first early to make room
+    if (DelayedProjectileCount >= Capacity)
+    {
+        if (SpawnTime <= DelayedProjectiles[DelayedProjectileHead].SpawnTime)
+        {
+            SpawnDelayedFakeProjectile(NewDelayedProjectile);
+            return;
+        }
+
+        FGSDelayedProjectileInfo& First(DelayedProjectiles[DelayedProjectileHead]);
+        DelayedProjectileHead = (DelayedProjectileHead + 1) % Capacity;
+        --DelayedProjectileCount;
+        SpawnDelayedFakeProjectile(First);
+    }
+
+    // SleepTime follows the ping, so a new entry can be due before entries already queued.
+    // Shift later entries one slot towards the tail to keep the buffer sorted by spawn time.
+    int32 Offset = DelayedProjectileCount;
+    while (Offset > 0)
+    {
+        const int32 PrevIndex = (DelayedProjectileHead + Offset - 1) % Capacity;
+
+        if (DelayedProjectiles[PrevIndex].SpawnTime <= SpawnTime)
+        {
+            break;
+        }
+
+        DelayedProjectiles[(DelayedProjectileHead + Offset) % Capacity] = DelayedProjectiles[PrevIndex];
+        --Offset;
+    }
+
+    DelayedProjectiles[(DelayedProjectileHead + Offset) % Capacity] = NewDelayedProjectile;
+    ++DelayedProjectileCount;
+
+    // The timer always targets the head entry, reschedule it when the new entry became the head
+    if ((Offset == 0) || ! GetWorldTimerManager().IsTimerActive(SpawnDelayedFakeProjHandle))
+    {
+        GetWorldTimerManager().SetTimer(
+            SpawnDelayedFakeProjHandle,
+            this,
+            &AGSWeapon::ProcessDelayedFakeProjectiles,
+            FMath::Max(DelayedProjectiles[DelayedProjectileHead].SpawnTime - CurrentTime, KINDA_SMALL_NUMBER),
+            false
+            );
+    }
+}
+
+void AGSWeapon::ProcessDelayedFakeProjectiles()
+{
+    const int32 Capacity = DelayedProjectiles.Num();
+    const float CurrentTime = GetWorld()->GetTimeSeconds();
+
+    while (DelayedProjectileCount > 0)
+    {
+        FGSDelayedProjectileInfo& DelayedProjectile(DelayedProjectiles[DelayedProjectileHead]);
+
+        if (DelayedProjectile.SpawnTime > CurrentTime)
+        {
+            break;
+        }
+
+        DelayedProjectileHead = (DelayedProjectileHead + 1) % Capacity;
+        --DelayedProjectileCount;
+        SpawnDelayedFakeProjectile(DelayedProjectile);
+    }
+
+    if (DelayedProjectileCount > 0)
+    {
+        const float NextSpawnTime = DelayedProjectiles[DelayedProjectileHead].SpawnTime;
+
+        GetWorldTimerManager().SetTimer(
+            SpawnDelayedFakeProjHandle,
+            this,
+            &AGSWeapon::ProcessDelayedFakeProjectiles,
+            FMath::Max(NextSpawnTime - CurrentTime, KINDA_SMALL_NUMBER),
+            false
+            );
+    }
+}
+
+void AGSWeapon::SpawnDelayedFakeProjectile(const FGSDelayedProjectileInfo& DelayedProjectile)
 {
     AGSPlayerController* OwningPlayer = OwningCharacter
         ? Cast<AGSPlayerController>(OwningCharacter->GetController())
@@ -681,13 +789,10 @@ AGSUTProjectile* AGSWeapon::ForwardTickProjectile(
                 );
         }
 
-        InProjectile->ProjectileMovement->TickComponent(
-            InCatchupTickDelta * InProjectile->CustomTimeDilation,
-            LEVELTICK_All,
-            NULL
-            );
+        InProjectile->CatchupTick(InCatchupTickDelta * InProjectile->CustomTimeDilation);
 
         InProjectile->SetForwardTicked(true);
+        InProjectile->RewindBallisticLaunch(InCatchupTickDelta * InProjectile->CustomTimeDilation);
 
         if (InProjectile->GetLifeSpan() > 0.f)
         {
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Abilities/Tasks/AbilityTask.h"
 #include "Abilities/Tasks/AbilityTask_WaitTargetData.h"
+#include "Abilities/GameplayAbilityTargetActor.h"
 #include "GSAT_ServerWaitForClientTargetData.generated.h"
 
 /**
@@ -18,8 +19,14 @@ class GASSHOOTER_API UGSAT_ServerWaitForClientTargetData : public UAbilityTask
 	UPROPERTY(BlueprintAssignable)
 	FWaitTargetDataDelegate	ValidData;
 
+	/**
+	* @param InTargetActor Optional. TargetActor that sanitizes/verifies the replicated TargetData with
+	* OnReplicatedTargetDataReceived() (VerifyReplicatedTargetData() for a GSGATA_Trace, e.g. with deterministic spread).
+	* Rejected TargetData is not broadcast. Required for spread shots, which replicate without hit results and are
+	* rejected without a GSGATA_Trace to regenerate them.
+	*/
 	UFUNCTION(BlueprintCallable, meta = (HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "true", HideSpawnParms = "Instigator"), Category = "Ability|Tasks")
-	static UGSAT_ServerWaitForClientTargetData* ServerWaitForClientTargetData(UGameplayAbility* OwningAbility, FName TaskInstanceName, bool TriggerOnce);
+	static UGSAT_ServerWaitForClientTargetData* ServerWaitForClientTargetData(UGameplayAbility* OwningAbility, FName TaskInstanceName, bool TriggerOnce, AGameplayAbilityTargetActor* InTargetActor = nullptr);
 
 	virtual void Activate() override;
 
@@ -30,4 +37,7 @@ protected:
 	virtual void OnDestroy(bool AbilityEnded) override;
 
 	bool bTriggerOnce;
+
+	UPROPERTY()
+	AGameplayAbilityTargetActor* TargetActor;
 };
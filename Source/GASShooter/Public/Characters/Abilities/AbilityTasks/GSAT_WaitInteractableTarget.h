@@ -5,12 +5,14 @@
 #include "CoreMinimal.h"
 #include "Abilities/Tasks/AbilityTask.h"
 #include "Engine/CollisionProfile.h"
+#include "Characters/Abilities/GSInteractionSubsystem.h"
 #include "GSAT_WaitInteractableTarget.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FWaitInteractableTargetDelegate, const FGameplayAbilityTargetDataHandle&, Data);
 
 /**
- * Performs a line trace on a timer, looking for an Actor that implements IGSInteractable that is available for interaction.
+ * Queries the interaction subsystem on a timer, looking for an Actor that implements IGSInteractable that is available for
+ * interaction. Candidates come from a cone around the player view and a single line trace confirms line of sight.
  * The StartLocations are hardcoded for GASShooter since we can be in first and third person so we have to check every time
  * we trace. If you only have one start location, you should make it more generic with a parameter on your AbilityTask node.
  */
@@ -26,13 +28,16 @@ class GASSHOOTER_API UGSAT_WaitInteractableTarget : public UAbilityTask
 	FWaitInteractableTargetDelegate LostInteractableTarget;
 
 	/**
-	* Traces a line on a timer looking for InteractableTargets.
+	* Looks for InteractableTargets on a timer.
+	* Scans are skipped while the player view and the nearby interactables don't change.
 	* @param MaxRange How far to trace.
 	* @param TimerPeriod Period of trace timer.
+	* @param FocusedTimerPeriod Period of trace timer while an interactable is in focus.
+	* @param ConeHalfAngle Half angle in degrees of the view cone interactables are searched in.
 	* @param bShowDebug Draws debug lines for traces.
 	*/
 	UFUNCTION(BlueprintCallable, meta = (HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "true", HideSpawnParms = "Instigator"), Category = "Ability|Tasks")
-	static UGSAT_WaitInteractableTarget* WaitForInteractableTarget(UGameplayAbility* OwningAbility, FName TaskInstanceName, FCollisionProfileName TraceProfile, float MaxRange = 200.0f, float TimerPeriod = 0.1f, bool bShowDebug = true);
+	static UGSAT_WaitInteractableTarget* WaitForInteractableTarget(UGameplayAbility* OwningAbility, FName TaskInstanceName, FCollisionProfileName TraceProfile, float MaxRange = 200.0f, float TimerPeriod = 0.1f, float FocusedTimerPeriod = 0.05f, float ConeHalfAngle = 5.0f, bool bShowDebug = true);
 
 	virtual void Activate() override;
 
@@ -45,27 +50,53 @@ protected:
 
 	float TimerPeriod;
 
-	bool bShowDebug;
+	float FocusedTimerPeriod;
+
+	float ConeHalfAngle;
+
+	// View changes below these thresholds don't trigger a scan
+	float ViewLocationThreshold;
+	float ViewRotationThreshold;
 
-	bool bTraceAffectsAimPitch;
+	// Scans at least this often to catch changes the interaction subsystem doesn't track (line of sight, polled availability)
+	float MaxSkipDuration;
+
+	// State of the last scan
+	bool bHasScanned;
+	bool bFocused;
+	FVector LastViewLocation;
+	FRotator LastViewRotation;
+	uint32 LastScanChangeSerial;
+	float LastScanTime;
+
+	bool bShowDebug;
 
 	FCollisionProfileName TraceProfile;
 
 	FGameplayAbilityTargetDataHandle TargetData;
 
+	// Identity of the target in TargetData, null if there is no valid, available Interactable Actor
+	TWeakObjectPtr<AActor> TargetActor;
+	TWeakObjectPtr<UPrimitiveComponent> TargetComponent;
+
 	FTimerHandle TraceTimerHandle;
 
-	virtual void OnDestroy(bool AbilityEnded) override;
+	// Scratch list of the interaction subsystem query
+	TArray<FGSInteractableCandidate> Candidates;
 
-	/** Traces as normal, but will manually filter all hit actors */
-	void LineTrace(FHitResult& OutHitResult, const UWorld* World, const FVector& Start, const FVector& End, FName ProfileName, const FCollisionQueryParams Params, bool bLookForInteractableActor) const;
+	virtual void OnDestroy(bool AbilityEnded) override;
 
-	void AimWithPlayerController(const AActor* InSourceActor, FCollisionQueryParams Params, const FVector& TraceStart, FVector& OutTraceEnd, bool bIgnorePitch = false) const;
+	/** Returns true if nothing blocks the trace from TraceStart to the candidate other than the candidate itself */
+	bool HasLineOfSight(const FVector& TraceStart, const FGSInteractableCandidate& Candidate, const FCollisionQueryParams& Params) const;
 
 	bool ClipCameraRayToAbilityRange(FVector CameraLocation, FVector CameraDirection, FVector AbilityCenter, float AbilityRange, FVector& ClippedPosition) const;
 
 	UFUNCTION()
 	void PerformTrace();
 
+	bool CanSkipScan(const UGSInteractionSubsystem* InteractionSubsystem, const FVector& ViewLocation, const FRotator& ViewRotation, const FVector& RangeCenter) const;
+
+	float GetCurrentTimerPeriod() const;
+
 	FGameplayAbilityTargetDataHandle MakeTargetData(const FHitResult& HitResult) const;
 };
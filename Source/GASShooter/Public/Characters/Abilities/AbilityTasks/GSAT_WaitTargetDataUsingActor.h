@@ -81,4 +81,7 @@ protected:
 	virtual void OnDestroy(bool AbilityEnded) override;
 
 	virtual bool ShouldReplicateDataToServer() const;
+
+	// Sends TargetData held by a UGSAbilitySystemComponent before another RPC of the ability
+	void FlushServerTargetDataBatch() const;
 };
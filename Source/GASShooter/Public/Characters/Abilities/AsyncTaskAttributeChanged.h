@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintAsyncActionBase.h"
 #include "AbilitySystemComponent.h"
+#include "Characters/Abilities/GSAbilityListenerHub.h"
 #include "AsyncTaskAttributeChanged.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnAttributeChanged, FGameplayAttribute, Attribute, float, NewValue, float, OldValue);
@@ -12,6 +13,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnAttributeChanged, FGameplayAtt
 /**
  * Blueprint node to automatically register a listener for all attribute changes in an AbilitySystemComponent.
  * Useful to use in UI.
+ * Listens through the ASC listener hub so any number of tasks share one delegate binding per attribute.
  */
 UCLASS(BlueprintType, meta=(ExposedAsyncProxy = AsyncTask))
 class GASSHOOTER_API UAsyncTaskAttributeChanged : public UBlueprintAsyncActionBase
@@ -23,13 +25,14 @@ public:
 	FOnAttributeChanged OnAttributeChanged;
 	
 	// Listens for an attribute changing.
+	// If bCoalescePerFrame is set, changes within a frame are broadcast once on the next tick.
 	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
-	static UAsyncTaskAttributeChanged* ListenForAttributeChange(UAbilitySystemComponent* AbilitySystemComponent, FGameplayAttribute Attribute);
+	static UAsyncTaskAttributeChanged* ListenForAttributeChange(UAbilitySystemComponent* AbilitySystemComponent, FGameplayAttribute Attribute, bool bCoalescePerFrame = false);
 
 	// Listens for an attribute changing.
 	// Version that takes in an array of Attributes. Check the Attribute output for which Attribute changed.
 	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
-	static UAsyncTaskAttributeChanged* ListenForAttributesChange(UAbilitySystemComponent* AbilitySystemComponent, TArray<FGameplayAttribute> Attributes);
+	static UAsyncTaskAttributeChanged* ListenForAttributesChange(UAbilitySystemComponent* AbilitySystemComponent, TArray<FGameplayAttribute> Attributes, bool bCoalescePerFrame = false);
 
 	// You must call this function manually when you want the AsyncTask to end.
 	// For UMG Widgets, you would call it in the Widget's Destruct event.
@@ -40,8 +43,9 @@ protected:
 	UPROPERTY()
 	UAbilitySystemComponent* ASC;
 
-	FGameplayAttribute AttributeToListenFor;
-	TArray<FGameplayAttribute> AttributesToListenFor;
+	FGSListenerHandle ListenerHandle;
 
-	void AttributeChanged(const FOnAttributeChangeData& Data);
+	static UAsyncTaskAttributeChanged* Listen(UAbilitySystemComponent* AbilitySystemComponent, TArrayView<const FGameplayAttribute> Attributes, bool bCoalescePerFrame);
+
+	void AttributeChanged(const FGameplayAttribute& Attribute, float NewValue, float OldValue);
 };
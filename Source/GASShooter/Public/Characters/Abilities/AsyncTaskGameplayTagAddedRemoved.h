@@ -6,6 +6,7 @@
 #include "Kismet/BlueprintAsyncActionBase.h"
 #include "AbilitySystemComponent.h"
 #include "GameplayTagContainer.h"
+#include "Characters/Abilities/GSAbilityListenerHub.h"
 #include "AsyncTaskGameplayTagAddedRemoved.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGameplayTagAddedRemoved, FGameplayTag, Tag);
@@ -13,6 +14,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGameplayTagAddedRemoved, FGamepla
 /**
  * Blueprint node to automatically register a listener for FGameplayTags added and removed.
  * Useful to use in Blueprint/UMG.
+ * Listens through the ASC listener hub so any number of tasks share one delegate binding per tag.
  */
 UCLASS(BlueprintType, meta = (ExposedAsyncProxy = AsyncTask))
 class GASSHOOTER_API UAsyncTaskGameplayTagAddedRemoved : public UBlueprintAsyncActionBase
@@ -41,5 +43,7 @@ protected:
 
 	FGameplayTagContainer Tags;
 
+	FGSListenerHandle ListenerHandle;
+
 	virtual void TagChanged(const FGameplayTag Tag, int32 NewCount);
 };
@@ -0,0 +1,130 @@
+// Copyright 2020 Dan Kestranek.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+#include "GameplayEffectTypes.h"
+#include "GameplayTagContainer.h"
+
+class UGSAbilitySystemComponent;
+
+DECLARE_DELEGATE_ThreeParams(FGSAttributeListenerDelegate, const FGameplayAttribute& /*Attribute*/, float /*NewValue*/, float /*OldValue*/);
+DECLARE_DELEGATE_TwoParams(FGSGameplayTagListenerDelegate, const FGameplayTag /*Tag*/, int32 /*NewCount*/);
+
+/**
+* Handle to a listener registered on FGSAbilityListenerHub.
+*/
+struct GASSHOOTER_API FGSListenerHandle
+{
+	FGSListenerHandle() : Id(0)
+	{
+	}
+
+	bool IsValid() const
+	{
+		return Id != 0;
+	}
+
+	void Reset()
+	{
+		Id = 0;
+	}
+
+	bool operator==(const FGSListenerHandle& Other) const
+	{
+		return Id == Other.Id;
+	}
+
+	bool operator!=(const FGSListenerHandle& Other) const
+	{
+		return Id != Other.Id;
+	}
+
+private:
+	friend class FGSAbilityListenerHub;
+
+	explicit FGSListenerHandle(uint32 InId) : Id(InId)
+	{
+	}
+
+	uint32 Id;
+};
+
+/**
+* Multiplexes any number of attribute and gameplay tag listeners over a single ASC delegate binding per attribute or tag.
+* Listeners are plain delegates identified by handles, no UObject is required per listener.
+*
+* Attribute listeners may opt into per-frame coalescing: all changes of an attribute within a frame are delivered once
+* on the next tick with the first old value and the latest new value.
+*/
+class GASSHOOTER_API FGSAbilityListenerHub
+{
+public:
+	explicit FGSAbilityListenerHub(UGSAbilitySystemComponent* InOwner = nullptr);
+	~FGSAbilityListenerHub();
+
+	FGSAbilityListenerHub(const FGSAbilityListenerHub&) = delete;
+	FGSAbilityListenerHub& operator=(const FGSAbilityListenerHub&) = delete;
+
+	// Listens for changes of the attributes. Returns an invalid handle if there are no valid attributes.
+	FGSListenerHandle ListenForAttributes(TArrayView<const FGameplayAttribute> Attributes, FGSAttributeListenerDelegate Delegate, bool bCoalescePerFrame = false);
+
+	// Listens for the tags being added (NewCount > 0) or removed (NewCount == 0). Returns an invalid handle if there are no tags.
+	FGSListenerHandle ListenForGameplayTags(const FGameplayTagContainer& Tags, FGSGameplayTagListenerDelegate Delegate);
+
+	// Removes the listener and resets the handle. Safe to call from inside a listener callback.
+	void RemoveListener(FGSListenerHandle& Handle);
+
+	// Delivers pending coalesced attribute changes. Called automatically on the tick following a change.
+	void FlushCoalescedChanges();
+
+	int32 GetNumListeners() const
+	{
+		return Listeners.Num();
+	}
+
+private:
+	struct FListener
+	{
+		TArray<FGameplayAttribute> Attributes;
+		TArray<FGameplayTag> Tags;
+		FGSAttributeListenerDelegate AttributeDelegate;
+		FGSGameplayTagListenerDelegate TagDelegate;
+		bool bCoalesce = false;
+	};
+
+	struct FAttributeChannel
+	{
+		FDelegateHandle BindingHandle;
+		TArray<uint32> ListenerIds;
+		int32 NumCoalescedListeners = 0;
+
+		// Pending coalesced change
+		bool bHasPendingChange = false;
+		float PendingOldValue = 0.0f;
+		float PendingNewValue = 0.0f;
+	};
+
+	struct FTagChannel
+	{
+		FDelegateHandle BindingHandle;
+		TArray<uint32> ListenerIds;
+	};
+
+	UGSAbilitySystemComponent* Owner;
+
+	TMap<uint32, FListener> Listeners;
+	TMap<FGameplayAttribute, FAttributeChannel> AttributeChannels;
+	TMap<FGameplayTag, FTagChannel> TagChannels;
+
+	uint32 NextListenerId;
+	bool bFlushScheduled;
+
+	uint32 AddListener(FListener&& Listener);
+
+	void OnAttributeChanged(const FOnAttributeChangeData& Data);
+	void OnTagChanged(const FGameplayTag Tag, int32 NewCount);
+
+	void ScheduleFlush();
+};
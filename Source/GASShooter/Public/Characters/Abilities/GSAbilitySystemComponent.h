@@ -4,10 +4,30 @@
 
 #include "CoreMinimal.h"
 #include "AbilitySystemComponent.h"
+#include "Characters/Abilities/GSAbilityListenerHub.h"
 #include "GSAbilitySystemComponent.generated.h"
 
 class USkeletalMeshComponent;
 
+/**
+* Character states derived from gameplay tags, see UGSAbilitySystemComponent::GetCharacterState().
+*/
+enum class EGSCharacterState : uint8
+{
+	None = 0,
+
+	// State.Interacting count is greater than State.InteractingRemoval count
+	Interacting = 1 << 0,
+
+	KnockedDown = 1 << 1,
+	Dead = 1 << 2,
+
+	// Aiming tag count is greater than aiming removal tag count, see UGSAbilitySystemComponent::SetAimingTags()
+	Aiming = 1 << 3,
+};
+
+ENUM_CLASS_FLAGS(EGSCharacterState);
+
 /**
 * Data about montages that were played locally (all montages in case of server. predictive montages in case of client). Never replicated directly.
 */
@@ -63,6 +83,45 @@ public:
 	}
 };
 
+/**
+* TargetData of one shot in a FGSServerTargetDataBatch.
+*/
+USTRUCT()
+struct GASSHOOTER_API FGSBatchedTargetData
+{
+	GENERATED_BODY();
+
+public:
+	// Prediction key of the window the shot was fired in
+	UPROPERTY()
+	FPredictionKey PredictionKey;
+
+	UPROPERTY()
+	FGameplayAbilityTargetDataHandle TargetData;
+};
+
+/**
+* TargetData of consecutive shots of one ability activation, sent to the server in one RPC.
+*/
+USTRUCT()
+struct GASSHOOTER_API FGSServerTargetDataBatch
+{
+	GENERATED_BODY();
+
+public:
+	UPROPERTY()
+	FGameplayAbilitySpecHandle AbilitySpecHandle;
+
+	UPROPERTY()
+	FPredictionKey ActivationPredictionKey;
+
+	UPROPERTY()
+	FGameplayTag ApplicationTag;
+
+	UPROPERTY()
+	TArray<FGSBatchedTargetData> Shots;
+};
+
 /**
  * 
  */
@@ -83,6 +142,8 @@ public:
 
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void InitAbilityActorInfo(AActor* InOwnerActor, AActor* InAvatarActor) override;
 
 	virtual void NotifyAbilityEnded(FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability, bool bWasCancelled) override;
@@ -93,10 +154,53 @@ public:
 	// Input bound to an ability is pressed
 	virtual void AbilityLocalInputPressed(int32 InputID) override;
 
+	virtual void AbilityLocalInputReleased(int32 InputID) override;
+
+	// Shared attribute and tag listeners, use instead of binding ASC delegates per listener
+	FGSAbilityListenerHub& GetListenerHub()
+	{
+		return ListenerHub;
+	}
+
+	// Character states kept current by gameplay tag events, use instead of tag count queries on hot paths
+	EGSCharacterState GetCharacterState() const
+	{
+		return CharacterState;
+	}
+
+	bool IsInteracting() const
+	{
+		return EnumHasAnyFlags(CharacterState, EGSCharacterState::Interacting);
+	}
+
+	bool IsKnockedDown() const
+	{
+		return EnumHasAnyFlags(CharacterState, EGSCharacterState::KnockedDown);
+	}
+
+	bool IsDead() const
+	{
+		return EnumHasAnyFlags(CharacterState, EGSCharacterState::Dead);
+	}
+
+	bool IsAiming() const
+	{
+		return EnumHasAnyFlags(CharacterState, EGSCharacterState::Aiming);
+	}
+
+	// Sets the tags of the Aiming state. Aiming tags are weapon specific so the current weapon's targeting sets them.
+	void SetAimingTags(const FGameplayTag& InAimingTag, const FGameplayTag& InAimingRemovalTag);
+
+	bool HasAimingTags(const FGameplayTag& InAimingTag, const FGameplayTag& InAimingRemovalTag) const
+	{
+		return AimingTag == InAimingTag && AimingRemovalTag == InAimingRemovalTag;
+	}
+
 	// Exposes GetTagCount to Blueprint
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Abilities", Meta = (DisplayName = "GetTagCount", ScriptName = "GetTagCount"))
 	int32 K2_GetTagCount(FGameplayTag TagToCheck) const;
 
+	// Returns the first ability spec granted for the class (optionally from the source object)
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Abilities")
 	FGameplayAbilitySpecHandle FindAbilitySpecHandleForClass(TSubclassOf<UGameplayAbility> AbilityClass, UObject* OptionalSourceObject=nullptr);
 
@@ -130,6 +234,17 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Abilities")
 	virtual bool BatchRPCTryActivateAbility(FGameplayAbilitySpecHandle InAbilityHandle, bool EndAbilityImmediately);
 
+	// TargetData sent by predicting clients outside of BatchRPCTryActivateAbility() (e.g. full auto shots after the first
+	// bullet) of abilities with bBatchServerTargetData is held for up to GS.ability.TargetDataBatchWindow seconds, sized
+	// from the measured shot interval, and sent to the server in one RPC. Activation, end, cancel (UGSGameplayAbility::CancelAbility), input and TargetData
+	// confirm/cancel RPCs send the held TargetData first so the server receives everything in order.
+	virtual void CallServerTryActivateAbility(FGameplayAbilitySpecHandle AbilityToActivate, bool InputPressed, FPredictionKey PredictionKey) override;
+	virtual void CallServerSetReplicatedTargetData(FGameplayAbilitySpecHandle AbilityHandle, FPredictionKey AbilityOriginalPredictionKey, const FGameplayAbilityTargetDataHandle& ReplicatedTargetDataHandle, FGameplayTag ApplicationTag, FPredictionKey CurrentPredictionKey) override;
+	virtual void CallServerEndAbility(FGameplayAbilitySpecHandle AbilityHandle, FGameplayAbilityActivationInfo ActivationInfo, FPredictionKey PredictionKey) override;
+
+	// Sends the TargetData held by CallServerSetReplicatedTargetData() to the server
+	void FlushServerTargetDataBatch();
+
 	UFUNCTION(BlueprintCallable, Category = "GameplayCue", Meta = (AutoCreateRefTerm = "GameplayCueParameters", GameplayTagFilter = "GameplayCue"))
 	void ExecuteGameplayCueLocal(const FGameplayTag GameplayCueTag, const FGameplayCueParameters& GameplayCueParameters);
 
@@ -214,6 +329,80 @@ public:
 	float GetCurrentMontageSectionTimeLeftForMesh(USkeletalMeshComponent* InMesh);
 
 protected:
+	FGSAbilityListenerHub ListenerHub;
+
+	EGSCharacterState CharacterState;
+
+	bool bCharacterStateTagEventsRegistered;
+
+	FGameplayTag AimingTag;
+	FGameplayTag AimingRemovalTag;
+
+	// Only our own bindings are removed when the aiming tags change, other listeners on the same tags stay bound
+	FDelegateHandle AimingTagEventHandle;
+	FDelegateHandle AimingRemovalTagEventHandle;
+
+	void RegisterCharacterStateTagEvents();
+
+	FDelegateHandle RegisterCharacterStateTagEvent(const FGameplayTag& Tag);
+	void UnregisterCharacterStateTagEvent(const FGameplayTag& Tag, FDelegateHandle& Handle);
+
+	void CharacterStateTagChanged(const FGameplayTag Tag, int32 NewCount);
+
+	void UpdateCharacterState();
+
+	virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+
+	// ----------------------------------------------------------------------------------------------------------------
+	//	Ability spec lookup by InputID and ability class, maintained in OnGiveAbility()/OnRemoveAbility().
+	// ----------------------------------------------------------------------------------------------------------------
+
+	struct FIndexedAbilitySpec
+	{
+		FGameplayAbilitySpecHandle Handle;
+
+		// Index in ActivatableAbilities.Items when last found, items are reordered when abilities are removed
+		int32 ItemIndex;
+	};
+
+	typedef TArray<FIndexedAbilitySpec, TInlineAllocator<4>> FIndexedAbilitySpecArray;
+
+	TMap<int32, FIndexedAbilitySpecArray> AbilitySpecsByInputID;
+
+	TMap<const UClass*, FIndexedAbilitySpecArray> AbilitySpecsByClass;
+
+	static void AddIndexedAbilitySpec(FIndexedAbilitySpecArray& IndexedSpecs, const FGameplayAbilitySpecHandle& Handle);
+
+	// Returns the spec of the indexed handle, refreshing its cached item index if it moved
+	FGameplayAbilitySpec* FindIndexedAbilitySpec(FIndexedAbilitySpec& IndexedSpec);
+
+	// TargetData held by a predicting client until FlushServerTargetDataBatch()
+	FGSServerTargetDataBatch PendingTargetDataBatch;
+
+	FTimerHandle TargetDataBatchTimerHandle;
+
+	float PendingTargetDataBatchStartTime;
+
+	// Last TargetData send of a batchable ability, to measure its fire rate
+	float LastBatchableShotTime;
+
+public:
+	// Fire rate of the batchable ability measured from consecutive TargetData sends, 0 for the first shot of a burst
+	float BatchableShotInterval;
+
+	// TargetData sent by this predicting client and the server RPCs it took, see GS.ability.TargetDataBatchStats
+	int32 NumTargetDataShotsSent;
+	int32 NumTargetDataRPCsSent;
+	double TotalTargetDataBatchDelay;
+
+protected:
+
+	UFUNCTION(Server, Reliable, WithValidation)
+	void ServerSetReplicatedTargetDataBatch(const FGSServerTargetDataBatch& Batch);
+	void ServerSetReplicatedTargetDataBatch_Implementation(const FGSServerTargetDataBatch& Batch);
+	bool ServerSetReplicatedTargetDataBatch_Validate(const FGSServerTargetDataBatch& Batch);
+
 	// ----------------------------------------------------------------------------------------------------------------
 	//	AnimMontage Support for multiple USkeletalMeshComponents on the AvatarActor.
 	//  Only one ability can be animating at a time though?
@@ -70,3 +70,103 @@ public:
 	void ClearTargets();
 };
 
+/**
+ * Target data of a trace shot with deterministic spread (see AGSGATA_Trace::bUseDeterministicSpread).
+ * Only the shot origin, aim direction, spread and shot index are replicated. The server regenerates the spread
+ * directions from the shot seed and traces them itself. HitResults are only valid locally.
+ *
+ * Effects are not applied to this data directly, ExpandHitResults() turns it into one SingleTargetHit per hit
+ * so every pellet gets its own hit result in the effect context.
+ */
+USTRUCT(BlueprintType)
+struct GASSHOOTER_API FGSGameplayAbilityTargetData_SpreadShot : public FGameplayAbilityTargetData
+{
+	GENERATED_BODY()
+
+public:
+	FGSGameplayAbilityTargetData_SpreadShot()
+		: TraceStart(ForceInitToZero)
+		, AimDirection(FVector::ForwardVector)
+		, Spread(0.0f)
+		, ShotIndex(0)
+	{}
+
+	UPROPERTY()
+	FVector_NetQuantize TraceStart;
+
+	UPROPERTY()
+	FVector AimDirection;
+
+	// Spread in degrees
+	UPROPERTY()
+	float Spread;
+
+	// Index of the shot within its ability activation. The spread seed is derived from it.
+	UPROPERTY()
+	int32 ShotIndex;
+
+	// Hit results of every trace of the shot. Not replicated.
+	UPROPERTY(NotReplicated)
+	TArray<FHitResult> HitResults;
+
+	// Rounds the shot to its replicated precision so the shooter traces the same directions as the server
+	void Quantize();
+
+	// Returns Data with every spread shot replaced by a FGameplayAbilityTargetData_SingleTargetHit per hit result
+	static FGameplayAbilityTargetDataHandle ExpandHitResults(const FGameplayAbilityTargetDataHandle& Data);
+
+	// Returns true if Data holds a spread shot. Replicated spread shots carry no hit results until an AGSGATA_Trace
+	// regenerates them (AGSGATA_Trace::VerifyReplicatedTargetData).
+	static bool ContainsSpreadShot(const FGameplayAbilityTargetDataHandle& Data);
+
+	virtual bool HasHitResult() const override
+	{
+		return HitResults.Num() > 0;
+	}
+
+	virtual const FHitResult* GetHitResult() const override
+	{
+		return HitResults.Num() > 0 ? &HitResults[0] : nullptr;
+	}
+
+	virtual bool HasOrigin() const override
+	{
+		return true;
+	}
+
+	virtual FTransform GetOrigin() const override
+	{
+		return FTransform(AimDirection.Rotation(), TraceStart);
+	}
+
+	virtual bool HasEndPoint() const override
+	{
+		return HitResults.Num() > 0;
+	}
+
+	virtual FVector GetEndPoint() const override
+	{
+		return HitResults.Num() > 0 ? FVector(HitResults[0].Location) : FVector::ZeroVector;
+	}
+
+	virtual UScriptStruct* GetScriptStruct() const override
+	{
+		return FGSGameplayAbilityTargetData_SpreadShot::StaticStruct();
+	}
+
+	virtual FString ToString() const override
+	{
+		return TEXT("FGSGameplayAbilityTargetData_SpreadShot");
+	}
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FGSGameplayAbilityTargetData_SpreadShot> : public TStructOpsTypeTraitsBase2<FGSGameplayAbilityTargetData_SpreadShot>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
@@ -0,0 +1,121 @@
+// Copyright 2020 Dan Kestranek.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/GameplayAbilityTargetDataFilter.h"
+#include "CollisionQueryParams.h"
+#include "Factions/FactionAgentInterface.h"
+
+/**
+* FGameplayTargetDataFilterHandle flattened for per hit evaluation. Built once per targeting from the filter handle, the
+* collision profile of the trace and the instigator's faction.
+*
+* Evaluates the fields of a plain FGameplayTargetDataFilter (as made by MakeFilterHandle) inline instead of calling the
+* virtual FilterPassesForActor() when the caller marks the filter as inline. Other filters, which may subclass
+* FGameplayTargetDataFilter, are evaluated through FilterPassesForActor(). The faction and object channel pre-filters
+* apply to both.
+*/
+struct GASSHOOTER_API FGSCompiledTargetDataFilter
+{
+public:
+	FGSCompiledTargetDataFilter();
+
+	/**
+	* @param Instigator Actor whose faction is used by bInFilterFriendlyFactions.
+	* @param bInlineFilter The filter is a plain FGameplayTargetDataFilter whose fields can be evaluated inline.
+	* @param bInFilterFriendlyFactions Actors of a faction friendly to the instigator's faction don't pass the filter.
+	* @param FilteredObjectChannels Object channels ignored by the trace query so their hits never reach the filter.
+	*/
+	void Compile(
+		const FGameplayTargetDataFilterHandle& FilterHandle,
+		const AActor* Instigator,
+		FName InProfileName,
+		bool bInlineFilter,
+		bool bInFilterFriendlyFactions,
+		const TArray<TEnumAsByte<ECollisionChannel>>& FilteredObjectChannels
+	);
+
+	void Reset();
+
+	bool IsCompiledFor(const FGameplayTargetDataFilterHandle& FilterHandle, FName InProfileName) const
+	{
+		return bCompiled && FilterHandle.Filter == SourceFilter && ProfileName == InProfileName;
+	}
+
+	// Adds the Actors that can never pass the filter to the query ignore list
+	void AddIgnoredActors(FCollisionQueryParams& Params) const;
+
+	ECollisionChannel GetTraceChannel() const
+	{
+		return TraceChannel;
+	}
+
+	const FCollisionResponseParams& GetResponseParams() const
+	{
+		return ResponseParams;
+	}
+
+	FORCEINLINE bool PassesForActor(const AActor* Actor)
+	{
+		if (bHasFilter)
+		{
+			bool bPasses = true;
+
+			if (SelfFilter == ETargetDataFilterSelf::TDFS_NoOthers)
+			{
+				bPasses = Actor == SelfActor;
+			}
+			else if (SelfFilter == ETargetDataFilterSelf::TDFS_NoSelf)
+			{
+				bPasses = Actor != SelfActor;
+			}
+
+			if (bPasses && RequiredActorClass && !Actor->IsA(RequiredActorClass))
+			{
+				bPasses = false;
+			}
+
+			if (bPasses == bReverseFilter)
+			{
+				return false;
+			}
+		}
+		else if (bHasVirtualFilter && !SourceFilter->FilterPassesForActor(Actor))
+		{
+			return false;
+		}
+
+		return !bFilterFriendlyFactions || !IsFriendly(Actor);
+	}
+
+protected:
+	struct FFactionAttitude
+	{
+		FFaction Faction;
+		bool bFriendly;
+	};
+
+	TSharedPtr<FGameplayTargetDataFilter> SourceFilter;
+	FName ProfileName;
+
+	const AActor* SelfActor;
+	UClass* RequiredActorClass;
+	TEnumAsByte<ETargetDataFilterSelf::Type> SelfFilter;
+	bool bReverseFilter;
+	bool bHasFilter;
+	bool bHasVirtualFilter;
+
+	bool bFilterFriendlyFactions;
+	FFaction InstigatorFaction;
+
+	// Attitude of the instigator's faction towards the factions seen so far
+	TArray<FFactionAttitude, TInlineAllocator<4>> FactionAttitudes;
+
+	ECollisionChannel TraceChannel;
+	FCollisionResponseParams ResponseParams;
+
+	bool bCompiled;
+
+	bool IsFriendly(const AActor* Actor);
+};
@@ -63,6 +63,8 @@ public:
 		* @param InNumberOfTraces Number of traces to perform. Intended to be used with BaseSpread for multi-shot weapons
 		* like shotguns. Not intended to be used with PersistentHitsResults. If using PersistentHitResults, NumberOfTraces is
 		* hardcoded to 1. You will need to add support for this in your project if you need it.
+		* @param bInUseDeterministicSpread Should the server regenerate the spread from a seed instead of receiving the hit
+		* results? Not used with PersistentHitResults.
 		*/
 	UFUNCTION(BlueprintCallable)
 	void Configure(
@@ -87,7 +89,8 @@ public:
 		UPARAM(DisplayName = "Targeting Spread Increment") float InTargetingSpreadIncrement = 0.0f,
 		UPARAM(DisplayName = "Targeting Spread Max") float InTargetingSpreadMax = 0.0f,
 		UPARAM(DisplayName = "Max Hit Results Per Trace") int32 InMaxHitResultsPerTrace = 1,
-		UPARAM(DisplayName = "Number of Traces") int32 InNumberOfTraces = 1
+		UPARAM(DisplayName = "Number of Traces") int32 InNumberOfTraces = 1,
+		UPARAM(DisplayName = "Use Deterministic Spread") bool bInUseDeterministicSpread = false
 	);
 
 	virtual void SphereTraceWithFilter(TArray<FHitResult>& OutHitResults, const UWorld* World, const FGameplayTargetDataFilterHandle FilterHandle, const FVector& Start, const FVector& End, float Radius, FName ProfileName, const FCollisionQueryParams Params);
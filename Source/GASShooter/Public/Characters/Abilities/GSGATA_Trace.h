@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Abilities/GameplayAbilityTargetActor.h"
+#include "Characters/Abilities/GSAbilityTypes.h"
+#include "Characters/Abilities/GSCompiledTargetDataFilter.h"
 #include "CollisionQueryParams.h"
 #include "DrawDebugHelpers.h"
 #include "Engine/CollisionProfile.h"
@@ -13,6 +15,106 @@
 
 class AGSHeroCharacter;
 
+/**
+ * Fixed capacity queue of persistent HitResults with an Actor lookup. Removed HitResults leave holes that are skipped
+ * instead of shifting the queue. Adding to a full queue evicts the oldest HitResult.
+ */
+struct GASSHOOTER_API FGSPersistentHitQueue
+{
+public:
+	FGSPersistentHitQueue();
+
+	// Clears the queue and sets its capacity
+	void Reset(int32 InCapacity);
+
+	// Clears the queue, keeps its capacity
+	void Empty();
+
+	void Add(const FHitResult& HitResult);
+
+	int32 Num() const
+	{
+		return NumHitResults;
+	}
+
+	bool Contains(const AActor* Actor) const
+	{
+		return ActorToSlot.Contains(Actor);
+	}
+
+	// Removes the HitResults matching the predicate
+	template<typename PredicateType>
+	void RemoveAll(PredicateType Predicate)
+	{
+		for (int32 Offset = 0; Offset < NumSlotsUsed; Offset++)
+		{
+			const int32 SlotIndex = GetSlotIndex(Offset);
+
+			if (Slots[SlotIndex].bUsed && Predicate(Slots[SlotIndex].HitResult))
+			{
+				RemoveSlot(SlotIndex);
+			}
+		}
+
+		TrimHoles();
+	}
+
+	// Calls Func(FHitResult&, int32 Index) from the oldest to the newest HitResult
+	template<typename FuncType>
+	void ForEach(FuncType Func)
+	{
+		int32 Index = 0;
+
+		for (int32 Offset = 0; Offset < NumSlotsUsed; Offset++)
+		{
+			FSlot& Slot = Slots[GetSlotIndex(Offset)];
+
+			if (Slot.bUsed)
+			{
+				Func(Slot.HitResult, Index++);
+			}
+		}
+	}
+
+	TArray<FHitResult> ToArray() const;
+
+protected:
+	struct FSlot
+	{
+		FHitResult HitResult;
+
+		// Lookup key, kept after the Actor is destroyed
+		const AActor* Actor;
+
+		bool bUsed;
+	};
+
+	TArray<FSlot> Slots;
+
+	TMap<const AActor*, int32> ActorToSlot;
+
+	// Oldest slot
+	int32 Head;
+
+	// Slots from Head to the newest HitResult, including holes
+	int32 NumSlotsUsed;
+
+	int32 NumHitResults;
+
+	int32 GetSlotIndex(int32 Offset) const
+	{
+		return (Head + Offset) % Slots.Num();
+	}
+
+	void RemoveSlot(int32 SlotIndex);
+
+	// Shrinks the used range to the oldest and newest HitResults
+	void TrimHoles();
+
+	// Moves the HitResults to the front of the slots to close holes
+	void Compact();
+};
+
 /**
  * Reusable, configurable trace TargetActor. Subclass with your own trace shapes.
  * Meant to be used with GSAT_WaitTargetDataUsingActor instead of the default WaitTargetData AbilityTask as the default
@@ -89,11 +191,40 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ExposeOnSpawn = true), Category = "Trace")
 	bool bUsePersistentHitResults;
 
+	// Filter is a plain FGameplayTargetDataFilter (as made by MakeFilterHandle) and is evaluated inline.
+	// Leave unset for filters subclassing FGameplayTargetDataFilter, they go through FilterPassesForActor().
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ExposeOnSpawn = true), Category = "Trace")
+	bool bInlineFilter;
+
+	// Hit Actors of a faction friendly to the SourceActor's faction don't pass the filter
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ExposeOnSpawn = true), Category = "Trace")
+	bool bFilterFriendlyFactions;
+
+	// Object channels ignored by the trace query itself, their Actors never reach the filter
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Trace")
+	TArray<TEnumAsByte<ECollisionChannel>> FilteredObjectChannels;
+
+	// Spread directions are generated from a seed derived from the activation prediction key and the shot index.
+	// The client only sends the shot origin, aim direction and spread (FGSGameplayAbilityTargetData_SpreadShot) and
+	// the server regenerates and traces the same directions. Spread increases once per shot instead of once per trace.
+	// Not used with PersistentHitResults.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ExposeOnSpawn = true), Category = "Trace")
+	bool bUseDeterministicSpread;
+
+	// Max distance between a replicated shot origin and the SourceActor before the server rejects the shot
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Trace")
+	float MaxShotOriginError;
+
 	UFUNCTION(BlueprintCallable)
 	virtual void ResetSpread();
 
 	virtual float GetCurrentSpread() const;
 
+	// Spread multiplier from aiming, 1 if not aiming
+	float GetAimingSpreadModifier() const;
+
+	static int32 GetShotSeed(int32 ActivationKey, int32 ShotIndex);
+
 	// Expose to Blueprint
 	UFUNCTION(BlueprintCallable)
 	void SetStartLocation(const FGameplayAbilityTargetingLocationInfo& InStartLocation);
@@ -112,6 +243,13 @@ public:
 
 	virtual void CancelTargeting() override;
 
+	/**
+	* Replaces a replicated FGSGameplayAbilityTargetData_SpreadShot with the hits of the regenerated shot, one
+	* SingleTargetHit per hit. Returns false if the shot is rejected. Other TargetData goes through
+	* OnReplicatedTargetDataReceived(). Call this instead of the const engine hook from tasks that own the actor.
+	*/
+	virtual bool VerifyReplicatedTargetData(FGameplayAbilityTargetDataHandle& Data);
+
 	virtual void BeginPlay() override;
 
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
@@ -134,9 +272,38 @@ protected:
 	FVector CurrentTraceEnd;
 	
 	TArray<TWeakObjectPtr<AGameplayAbilityWorldReticle>> ReticleActors;
-	TArray<FHitResult> PersistentHitResults;
+
+	// Filter compiled in StartTargeting()
+	FGSCompiledTargetDataFilter CompiledFilter;
+	FGSPersistentHitQueue PersistentHitResults;
+
+	// Deterministic spread: shot traced by the last PerformTrace()
+	FGSGameplayAbilityTargetData_SpreadShot CurrentShot;
+	FRandomStream SpreadStream;
+	int32 ShotActivationKey;
+	int32 NextShotIndex;
+
+	// Server: index the next replicated shot of the activation must have
+	int32 ExpectedShotIndex;
+	bool bReplayingShot;
+
+	bool UsesDeterministicSpread() const
+	{
+		return bUseDeterministicSpread && !bUsePersistentHitResults;
+	}
+
+	// Aim direction before spread
+	virtual FVector ComputeAimDirection(const AActor* InSourceActor, const FCollisionQueryParams& Params, const FVector& TraceStart);
+
+	FVector ApplySpread(const FVector& AimDir, float Spread);
+
+	// Fills CurrentShot from the player aim
+	void BeginShot(const AActor* InSourceActor, const FCollisionQueryParams& Params, const FVector& TraceStart);
+
+	bool RegenerateShot(FGSGameplayAbilityTargetData_SpreadShot& Shot);
 
 	virtual FGameplayAbilityTargetDataHandle MakeTargetData(const TArray<FHitResult>& HitResults) const;
+	virtual FGameplayAbilityTargetDataHandle MakeSpreadShotTargetData(const TArray<FHitResult>& HitResults) const;
 	virtual TArray<FHitResult> PerformTrace(AActor* InSourceActor);
 
 	virtual void DoTrace(TArray<FHitResult>& HitResults, const UWorld* World, const FGameplayTargetDataFilterHandle FilterHandle, const FVector& Start, const FVector& End, FName ProfileName, const FCollisionQueryParams Params) PURE_VIRTUAL(AGSGATA_Trace, return;);
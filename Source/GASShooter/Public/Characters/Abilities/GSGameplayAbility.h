@@ -69,6 +69,13 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Ability")
 	bool bCannotActivateWhileInteracting;
 
+	// If true, TargetData the predicting client sends after activation may be held and sent with the next shots in one
+	// RPC (see GS.ability.TargetDataBatchWindow). Only enable for abilities that consume TargetData on the server as
+	// soon as it arrives (e.g. ServerWaitForClientTargetData without TriggerOnce), a task registering later only sees
+	// the last TargetData of a batch.
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "Ability")
+	bool bBatchServerTargetData;
+
 	// Map of gameplay tags to gameplay effect containers
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GameplayEffects")
 	TMap<FGameplayTag, FGSGameplayEffectContainer> EffectContainerMap;
@@ -126,6 +133,9 @@ public:
 
 	virtual void ApplyCost(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo) const override;
 
+	// Sends held TargetData before the cancel is replicated
+	virtual void CancelAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateCancelAbility) override;
+
 	// Allows C++ and Blueprint abilities to override how cost is applied in case they don't use a GE like weapon ammo
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Ability")
 	void GSApplyCost(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo& ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo) const;
@@ -0,0 +1,159 @@
+// Copyright 2020 Dan Kestranek.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GSInteractionSubsystem.generated.h"
+
+class UPrimitiveComponent;
+
+/**
+* Interactable candidate returned by UGSInteractionSubsystem::QueryCone().
+*/
+struct FGSInteractableCandidate
+{
+	UPrimitiveComponent* Component;
+	AActor* Actor;
+
+	// Point on the component bounds closest to the query ray
+	FVector Location;
+
+	// Distance along the query ray, candidates are sorted by it
+	float Distance;
+};
+
+/**
+* Registry of interactable components (components of IGSInteractable Actors that overlap COLLISION_INTERACTABLE).
+*
+* Static components are kept in a spatial hash, movable components (e.g. heroes) in a flat list that refreshes bounds
+* on query. Actors are registered automatically when spawned or when their level is added to the world.
+*
+* Availability can be pushed by the interactable with SetInteractableAvailable(). Components that never pushed their
+* availability fall back to IGSInteractable::IsAvailableForInteraction() for the candidates of a query.
+*/
+UCLASS()
+class GASSHOOTER_API UGSInteractionSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UGSInteractionSubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// Registers every interactable component of the Actor. Does nothing if the Actor is not IGSInteractable.
+	void RegisterInteractableActor(AActor* Actor);
+
+	void UnregisterInteractableActor(AActor* Actor);
+
+	UFUNCTION(BlueprintCallable, Category = "GASShooter|Interaction")
+	void RegisterInteractable(UPrimitiveComponent* Component);
+
+	UFUNCTION(BlueprintCallable, Category = "GASShooter|Interaction")
+	void UnregisterInteractable(UPrimitiveComponent* Component);
+
+	// Pushes the availability of the component, registers it if needed
+	UFUNCTION(BlueprintCallable, Category = "GASShooter|Interaction")
+	void SetInteractableAvailable(UPrimitiveComponent* Component, bool bAvailable);
+
+	// Re-hashes a static component that was moved
+	UFUNCTION(BlueprintCallable, Category = "GASShooter|Interaction")
+	void UpdateInteractableBounds(UPrimitiveComponent* Component);
+
+	/**
+	* Finds available interactables whose bounds intersect a cone around the ray and are within range of RangeCenter.
+	*
+	* @param RayOrigin Cone apex, usually the player view location.
+	* @param RayDirection Normalized cone direction.
+	* @param RangeCenter Candidates must be within MaxRange of this location, usually the ability source.
+	* @param ConeHalfAngle Cone half angle in degrees.
+	*/
+	void QueryCone(
+		const FVector& RayOrigin,
+		const FVector& RayDirection,
+		const FVector& RangeCenter,
+		float MaxRange,
+		float ConeHalfAngle,
+		const AActor* IgnoreActor,
+		TArray<FGSInteractableCandidate>& OutCandidates
+		);
+
+	int32 GetNumInteractables() const
+	{
+		return Entries.Num();
+	}
+
+	// Serial incremented on every registration, removal, bounds or availability change
+	uint32 GetChangeSerial() const
+	{
+		return ChangeSerial;
+	}
+
+	/**
+	* Returns true if an interactable within Radius of Center changed after Serial. Availability of interactables that
+	* don't push it with SetInteractableAvailable() is not tracked.
+	*/
+	bool HasChangedSince(const FVector& Center, float Radius, uint32 Serial) const;
+
+protected:
+	struct FEntry
+	{
+		TWeakObjectPtr<UPrimitiveComponent> Component;
+		TWeakObjectPtr<AActor> Actor;
+		FVector Center;
+		float Radius;
+		FIntVector Cell;
+		bool bMovable;
+		bool bAvailable;
+
+		// Availability was pushed by the interactable, no need to ask it
+		bool bTrackedAvailability;
+
+		uint32 ChangeSerial;
+	};
+
+	// Size of a spatial hash cell
+	float CellSize;
+
+	TSparseArray<FEntry> Entries;
+
+	TMap<TWeakObjectPtr<UPrimitiveComponent>, int32> ComponentToEntry;
+
+	// Static entries by cell
+	TMap<FIntVector, TArray<int32>> Cells;
+
+	TArray<int32> MovableEntries;
+
+	uint32 ChangeSerial;
+
+	// Last change serial by cell, kept after the cell is emptied
+	TMap<FIntVector, uint32> CellChangeSerials;
+
+	// Movable entries can't be located once removed, any removal counts as a change everywhere
+	uint32 MovableRemovedSerial;
+
+	// Largest bounds radius of the static entries, added to the query extents
+	float MaxStaticRadius;
+
+	FDelegateHandle ActorSpawnedDelegateHandle;
+	FDelegateHandle LevelAddedDelegateHandle;
+
+	void OnActorSpawned(AActor* Actor);
+	void OnLevelAddedToWorld(ULevel* Level, UWorld* World);
+
+	static bool IsInteractableComponent(const UPrimitiveComponent* Component);
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	void AddToCell(int32 EntryIndex);
+	void RemoveFromCell(int32 EntryIndex);
+	void RemoveEntry(int32 EntryIndex);
+
+	void MarkChanged(FEntry& Entry);
+
+	bool IsEntryAvailable(const FEntry& Entry) const;
+};
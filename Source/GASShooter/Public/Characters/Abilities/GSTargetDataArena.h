@@ -0,0 +1,76 @@
+// Copyright 2020 Dan Kestranek.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/GameplayAbilityTargetTypes.h"
+#include "HAL/CriticalSection.h"
+
+/**
+* Block allocator for the FGameplayAbilityTargetData made by GS target data producers (target actors, abilities,
+* effect containers).
+*
+* TargetData is bump allocated from 64KB blocks and handed to the FGameplayAbilityTargetDataHandle with a deleter that
+* only counts it out of its block. TargetData can outlive the frame that made it (e.g. in effect contexts) so a block
+* is recycled as a whole once all of its TargetData is released.
+*/
+class GASSHOOTER_API FGSTargetDataArena
+{
+public:
+	// Constructs a TargetDataType in the arena and adds it to the handle
+	template<typename TargetDataType, typename... ArgTypes>
+	static TargetDataType* Add(FGameplayAbilityTargetDataHandle& Handle, ArgTypes&&... Args)
+	{
+		static_assert(TIsDerivedFrom<TargetDataType, FGameplayAbilityTargetData>::IsDerived, "TargetDataType must derive from FGameplayAbilityTargetData");
+
+		void* Memory = Get().Allocate(sizeof(TargetDataType), alignof(TargetDataType));
+		TargetDataType* TargetData = new (Memory) TargetDataType(Forward<ArgTypes>(Args)...);
+
+		Handle.Data.Add(TSharedPtr<FGameplayAbilityTargetData>(TargetData, FDeleter()));
+
+		return TargetData;
+	}
+
+	static FGSTargetDataArena& Get();
+
+	int32 GetNumBlocks() const
+	{
+		return NumBlocks;
+	}
+
+private:
+	struct FBlock
+	{
+		FBlock* NextFree;
+		int32 Used;
+		int32 NumLive;
+	};
+
+	struct FDeleter
+	{
+		void operator()(FGameplayAbilityTargetData* TargetData) const
+		{
+			TargetData->~FGameplayAbilityTargetData();
+			FGSTargetDataArena::Get().Free(TargetData);
+		}
+	};
+
+	FGSTargetDataArena();
+
+	FCriticalSection CriticalSection;
+
+	// Block allocations are made from
+	FBlock* CurrentBlock;
+
+	// Released blocks kept for reuse
+	FBlock* FreeBlocks;
+	int32 NumFreeBlocks;
+
+	int32 NumBlocks;
+
+	void* Allocate(SIZE_T Size, uint32 Alignment);
+	void Free(void* Memory);
+
+	FBlock* AcquireBlock();
+	void ReleaseBlock(FBlock* Block);
+};
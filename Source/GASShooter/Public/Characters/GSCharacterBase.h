@@ -50,6 +50,12 @@ public:
     // Implement IAbilitySystemInterface
     virtual class UAbilitySystemComponent* GetAbilitySystemComponent() const override;
 
+    // Non-virtual typed ASC access for hot paths
+    FORCEINLINE class UGSAbilitySystemComponent* GetGSAbilitySystemComponent() const
+    {
+        return AbilitySystemComponent;
+    }
+
     UFUNCTION(BlueprintCallable, Category = "GASShooter|GSCharacter")
     virtual bool IsAlive() const;
 
@@ -4,10 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/CharacterMovementComponent.h"
-#include "GameplayTagContainer.h"
 #include "Library/ALSCharacterStructLibrary.h"
 #include "GSCharacterMovementComponent.generated.h"
 
+class AGSHeroCharacter;
+
 /**
  * 
  */
@@ -45,6 +46,38 @@ class GASSHOOTER_API UGSCharacterMovementComponent : public UCharacterMovementCo
 
 		// Aim Down Sights
 		uint8 SavedRequestToStartADS : 1;
+
+		// Aim yaw compressed to 16 bits
+		uint16 SavedAimYaw;
+
+		// AGSHeroCharacter::PackALSState()
+		uint32 SavedALSState;
+	};
+
+	/** Move data sent to the server, extended with the compressed aim yaw and the packed ALS state. */
+	class FGSCharacterNetworkMoveData : public FCharacterNetworkMoveData
+	{
+	public:
+
+		typedef FCharacterNetworkMoveData Super;
+
+		FGSCharacterNetworkMoveData();
+
+		virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+
+		virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+
+		uint16 AimYaw;
+
+		uint32 ALSState;
+	};
+
+	class FGSCharacterNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
+	{
+	public:
+		FGSCharacterNetworkMoveDataContainer();
+
+		FGSCharacterNetworkMoveData GSMoveData[3];
 	};
 
 	class FGSNetworkPredictionData_Client : public FNetworkPredictionData_Client_Character
@@ -74,10 +107,6 @@ public:
 	uint8 RequestToStartSprinting : 1;
 	uint8 RequestToStartADS : 1;
 
-	FGameplayTag KnockedDownTag;
-	FGameplayTag InteractingTag;
-	FGameplayTag InteractingRemovalTag;
-
     /** ALS */
 
 	// Movement Settings Variables
@@ -98,12 +127,34 @@ public:
 
 public:
 
+	virtual void SetUpdatedComponent(USceneComponent* NewUpdatedComponent) override;
+
 	virtual float GetMaxSpeed() const override;
 	virtual float GetMaxAcceleration() const override;
 	virtual float GetMaxBrakingDeceleration() const override;
 	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
 	virtual class FNetworkPredictionData_Client* GetPredictionData_Client() const override;
 
+protected:
+
+	// Applies the aim yaw and ALS states carried by a verified move before performing it on the server
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel) override;
+
+	FGSCharacterNetworkMoveDataContainer GSNetworkMoveDataContainer;
+
+	// CharacterOwner as a hero, set with the updated component
+	UPROPERTY(Transient, DuplicateTransient)
+	AGSHeroCharacter* HeroOwner;
+
+	// Speed of CurrentMovementSettings for the gait requested by CachedGaitSpeedKey
+	mutable float CachedGaitSpeed;
+	mutable uint8 CachedGaitSpeedKey;
+
+	// Gait speed key of the current walk and sprint requests
+	uint8 GetGaitSpeedKey() const;
+
+public:
+
 	// Walk
 	UFUNCTION(BlueprintCallable, Category = "Walk")
 	void StartWalking();
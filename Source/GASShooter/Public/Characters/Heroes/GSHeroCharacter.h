@@ -6,6 +6,7 @@
 #include "Engine/DataTable.h"
 #include "GameplayEffectTypes.h"
 #include "Characters/GSCharacterBase.h"
+#include "Characters/Abilities/GSAbilityListenerHub.h"
 #include "Characters/Abilities/GSInteractable.h"
 #include "Library/ALSCharacterEnumLibrary.h"
 #include "Library/ALSCharacterStructLibrary.h"
@@ -50,6 +51,93 @@ struct GASSHOOTER_API FGSHeroInventory
     // Etc
 };
 
+/**
+ * Movement input and control rotation of a hero, quantized for simulated proxies.
+ * Acceleration is an 8-bit per axis direction plus an 8-bit fraction of the max acceleration,
+ * control rotation is pitch/yaw compressed to 16 bits each. Roll is not sent.
+ */
+USTRUCT()
+struct GASSHOOTER_API FGSQuantizedMovementInput
+{
+    GENERATED_USTRUCT_BODY()
+
+    UPROPERTY()
+    int8 AccelerationDirX;
+
+    UPROPERTY()
+    int8 AccelerationDirY;
+
+    UPROPERTY()
+    int8 AccelerationDirZ;
+
+    // Acceleration size as a fraction of the max acceleration, 0-255
+    UPROPERTY()
+    uint8 AccelerationAmount;
+
+    UPROPERTY()
+    uint16 ControlPitch;
+
+    UPROPERTY()
+    uint16 ControlYaw;
+
+    FGSQuantizedMovementInput()
+        : AccelerationDirX(0)
+        , AccelerationDirY(0)
+        , AccelerationDirZ(0)
+        , AccelerationAmount(0)
+        , ControlPitch(0)
+        , ControlYaw(0)
+    {}
+
+    FGSQuantizedMovementInput(const FVector& Acceleration, float MaxAcceleration, const FRotator& ControlRotation);
+
+    FVector GetAcceleration(float MaxAcceleration) const;
+
+    FRotator GetControlRotation() const;
+
+    // True if the difference to Other is above the GS.Movement.InputRep* thresholds.
+    // Starting or stopping movement input is always significant.
+    bool IsSignificantlyDifferent(const FGSQuantizedMovementInput& Other) const;
+
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+    {
+        Ar << AccelerationDirX;
+        Ar << AccelerationDirY;
+        Ar << AccelerationDirZ;
+        Ar << AccelerationAmount;
+        Ar << ControlPitch;
+        Ar << ControlYaw;
+
+        bOutSuccess = true;
+        return true;
+    }
+
+    bool operator==(const FGSQuantizedMovementInput& Other) const
+    {
+        return AccelerationDirX == Other.AccelerationDirX
+            && AccelerationDirY == Other.AccelerationDirY
+            && AccelerationDirZ == Other.AccelerationDirZ
+            && AccelerationAmount == Other.AccelerationAmount
+            && ControlPitch == Other.ControlPitch
+            && ControlYaw == Other.ControlYaw;
+    }
+
+    bool operator!=(const FGSQuantizedMovementInput& Other) const
+    {
+        return !(*this == Other);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FGSQuantizedMovementInput> : public TStructOpsTypeTraitsBase2<FGSQuantizedMovementInput>
+{
+    enum
+    {
+        WithNetSerializer = true,
+        WithIdenticalViaEquality = true
+    };
+};
+
 /**
  * A player or AI controlled hero character.
  */
@@ -71,7 +159,9 @@ public:
     // Only called on the Server. Calls before Server's AcknowledgePossession.
     virtual void PossessedBy(AController* NewController) override;
 
-    class UGSFloatingStatusBarWidget* GetFloatingStatusBar();
+    // Registers the floating status bar of this hero on the local player HUD overlay.
+    // Safe to call many times because it checks to make sure it only registers once.
+    void InitializeFloatingStatusBar();
 
     // Server handles knockdown - cancel abilities, remove effects, activate knockdown ability
     virtual void KnockDown();
@@ -108,8 +198,17 @@ public:
 
     FVector GetProjectionAnchorOffset() const;
 
+    // Sets the local aim rotation. Autonomous proxies send the aim yaw
+    // to the server with their saved moves.
     void SetAimingRotation(FRotator NewAimRotation);
 
+    // Packs the ALS input and character states (desired gait, stance and rotation mode, rotation mode,
+    // view mode and overlay state). Autonomous proxies send it to the server with their saved moves.
+    uint32 PackALSState() const;
+
+    // Applies a packed ALS state received with a client move (server) or replicated (simulated proxies)
+    void ApplyALSState(uint32 PackedState);
+
     virtual FRotator GetViewRotation() const override;
 
     UFUNCTION(BlueprintCallable)
@@ -251,15 +350,6 @@ protected:
     UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "GASShooter|GSHeroCharacter")
     FName WeaponAttachPoint;
 
-    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GASShooter|UI")
-    TSubclassOf<class UGSFloatingStatusBarWidget> UIFloatingStatusBarClass;
-
-    UPROPERTY()
-    class UGSFloatingStatusBarWidget* UIFloatingStatusBar;
-
-    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "GASShooter|UI")
-    class UWidgetComponent* UIFloatingStatusBarComponent;
-
     UPROPERTY(ReplicatedUsing = OnRep_Inventory)
     FGSHeroInventory Inventory;
 
@@ -303,6 +393,7 @@ protected:
 
     // Tag changed delegate handles
     FDelegateHandle WeaponChangingDelayReplicationTagChangedDelegateHandle;
+    FGSListenerHandle InteractableTagsListenerHandle;
 
     // Top-down control
 
@@ -358,14 +449,6 @@ protected:
     // Mouse + Gamepad
     void MoveRight(float Value);
 
-    UFUNCTION(BlueprintCallable, Server, Reliable)
-    void Server_SetAimingRotation(FRotator NewAimRotation);
-
-    // Creates and initializes the floating status bar for heroes.
-    // Safe to call many times because it checks to make sure it only executes once.
-    UFUNCTION()
-    void InitializeFloatingStatusBar();
-
     // Client only
     virtual void OnRep_PlayerState() override;
     virtual void OnRep_Controller() override;
@@ -402,6 +485,13 @@ protected:
 
     // Tag changed callbacks
     virtual void WeaponChangingDelayReplicationTagChanged(const FGameplayTag CallbackTag, int32 NewCount);
+    virtual void InteractableTagsChanged(const FGameplayTag CallbackTag, int32 NewCount);
+
+    // Listens for the tags that change revive availability, called once the ASC is set
+    void BindInteractableAvailability();
+
+    // Pushes revive availability to the interaction subsystem
+    void UpdateInteractableAvailability();
 
     UFUNCTION()
     void OnRep_CurrentWeapon(AGSWeapon* LastWeapon);
@@ -438,13 +528,13 @@ protected:
 
     /** Input */
 
-    UPROPERTY(EditAnywhere, Replicated, BlueprintReadWrite, Category = "ALS|Input")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Input")
     EALSRotationMode DesiredRotationMode = EALSRotationMode::LookingDirection;
 
-    UPROPERTY(EditAnywhere, Replicated, BlueprintReadWrite, Category = "ALS|Input")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Input")
     EALSGait DesiredGait = EALSGait::Running;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "ALS|Input")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Input")
     EALSStance DesiredStance = EALSStance::Standing;
 
     UPROPERTY(EditDefaultsOnly, Category = "ALS|Input", BlueprintReadOnly)
@@ -481,7 +571,7 @@ protected:
 
     /** State Values */
 
-    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|State Values", ReplicatedUsing = OnRep_OverlayState)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|State Values")
     EALSOverlayState OverlayState = EALSOverlayState::Default;
 
     /** Movement System */
@@ -520,12 +610,17 @@ protected:
     UPROPERTY(BlueprintReadOnly, Category = "ALS|Essential Information")
     float EasedMaxAcceleration = 0.0f;
 
-    UPROPERTY(BlueprintReadOnly, Replicated, Category = "ALS|Essential Information")
+    // Full precision on the server and owner, dequantized from ReplicatedMovementInput on simulated proxies
+    UPROPERTY(BlueprintReadOnly, Category = "ALS|Essential Information")
     FVector ReplicatedCurrentAcceleration = FVector::ZeroVector;
 
-    UPROPERTY(BlueprintReadOnly, Replicated, Category = "ALS|Essential Information")
+    UPROPERTY(BlueprintReadOnly, Category = "ALS|Essential Information")
     FRotator ReplicatedControlRotation = FRotator::ZeroRotator;
 
+    // Only updated on the server when the change is significant
+    UPROPERTY(ReplicatedUsing = OnRep_ReplicatedMovementInput)
+    FGSQuantizedMovementInput ReplicatedMovementInput;
+
     /** State Values */
 
     UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values")
@@ -537,7 +632,7 @@ protected:
     UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values")
     EALSMovementAction MovementAction = EALSMovementAction::None;
 
-    UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values", ReplicatedUsing = OnRep_RotationMode)
+    UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values")
     EALSRotationMode RotationMode = EALSRotationMode::LookingDirection;
 
     UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values")
@@ -546,7 +641,7 @@ protected:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|State Values")
     EALSStance Stance = EALSStance::Standing;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|State Values", ReplicatedUsing = OnRep_ViewMode)
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|State Values")
     EALSViewMode ViewMode = EALSViewMode::ThirdPerson;
 
     /** Movement System */
@@ -729,24 +824,15 @@ protected:
     UFUNCTION(BlueprintSetter, Category = "ALS|Input")
     void SetDesiredStance(EALSStance NewStance);
 
-    UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Input")
-    void Server_SetDesiredStance(EALSStance NewStance);
-
     UFUNCTION(BlueprintCallable, Category = "ALS|Character States")
     void SetDesiredGait(EALSGait NewGait);
 
-    UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Character States")
-    void Server_SetDesiredGait(EALSGait NewGait);
-
     UFUNCTION(BlueprintGetter, Category = "ALS|Input")
     EALSRotationMode GetDesiredRotationMode() const { return DesiredRotationMode; }
 
     UFUNCTION(BlueprintSetter, Category = "ALS|Input")
     void SetDesiredRotationMode(EALSRotationMode NewRotMode);
 
-    UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Character States")
-    void Server_SetDesiredRotationMode(EALSRotationMode NewRotMode);
-
     UFUNCTION(BlueprintGetter, Category = "ALS|Character States")
     EALSGait GetGait() const { return Gait; }
 
@@ -756,27 +842,18 @@ protected:
     UFUNCTION(BlueprintCallable, Category = "ALS|Character States")
     void SetRotationMode(EALSRotationMode NewRotationMode);
 
-    UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Character States")
-    void Server_SetRotationMode(EALSRotationMode NewRotationMode);
-
     UFUNCTION(BlueprintGetter, Category = "ALS|Character States")
     EALSRotationMode GetRotationMode() const { return RotationMode; }
 
     UFUNCTION(BlueprintCallable, Category = "ALS|Character States")
     void SetViewMode(EALSViewMode NewViewMode);
 
-    UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Character States")
-    void Server_SetViewMode(EALSViewMode NewViewMode);
-
     UFUNCTION(BlueprintGetter, Category = "ALS|Character States")
     EALSViewMode GetViewMode() const { return ViewMode; }
 
     UFUNCTION(BlueprintCallable, Category = "ALS|Character States")
     void SetOverlayState(EALSOverlayState NewState);
 
-    UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Character States")
-    void Server_SetOverlayState(EALSOverlayState NewState);
-
     UFUNCTION(BlueprintGetter, Category = "ALS|Character States")
     EALSOverlayState GetOverlayState() const { return OverlayState; }
 
@@ -838,12 +915,16 @@ protected:
 
     /** Replication */
 
-    UFUNCTION(Category = "ALS|Replication")
-    void OnRep_RotationMode(EALSRotationMode PrevRotMode);
+    // PackALSState() of the server, replicated to simulated proxies
+    UPROPERTY(ReplicatedUsing = OnRep_ReplicatedALSState)
+    uint32 ReplicatedALSState = 0;
+
+    // Packs the current state into ReplicatedALSState on the server
+    void UpdateReplicatedALSState();
 
     UFUNCTION(Category = "ALS|Replication")
-    void OnRep_ViewMode(EALSViewMode PrevViewMode);
+    void OnRep_ReplicatedALSState();
 
     UFUNCTION(Category = "ALS|Replication")
-    void OnRep_OverlayState(EALSOverlayState PrevOverlayState);
+    void OnRep_ReplicatedMovementInput();
 };
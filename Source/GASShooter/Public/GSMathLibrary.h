@@ -7,6 +7,71 @@
 #include "Kismet/KismetSystemLibrary.h"
 #include "GSMathLibrary.generated.h"
 
+/**
+ * Structure of arrays of vertical capsules for the batch intersection functions.
+ */
+struct GASSHOOTER_API FGSCapsuleSoA
+{
+    TArray<float> X;
+    TArray<float> Y;
+    TArray<float> Z;
+    TArray<float> Radius;
+    TArray<float> HalfHeight;
+
+    void Reserve(int32 Num);
+    void Reset();
+    void Add(const FVector& Location, float InRadius, float InHalfHeight);
+
+    FORCEINLINE int32 Num() const
+    {
+        return X.Num();
+    }
+};
+
+/**
+ * Structure of arrays of swept spheres for the batch intersection functions.
+ */
+struct GASSHOOTER_API FGSSweptSphereSoA
+{
+    TArray<float> StartX;
+    TArray<float> StartY;
+    TArray<float> StartZ;
+    TArray<float> EndX;
+    TArray<float> EndY;
+    TArray<float> EndZ;
+    TArray<float> Radius;
+
+    void Reserve(int32 Num);
+    void Reset();
+    void Add(const FVector& Start, const FVector& End, float InRadius);
+
+    FORCEINLINE int32 Num() const
+    {
+        return StartX.Num();
+    }
+};
+
+/**
+ * Structure of arrays of segments for the batch intersection functions.
+ */
+struct GASSHOOTER_API FGSSegmentSoA
+{
+    TArray<float> StartX;
+    TArray<float> StartY;
+    TArray<float> StartZ;
+    TArray<float> EndX;
+    TArray<float> EndY;
+    TArray<float> EndZ;
+
+    void Reserve(int32 Num);
+    void Reset();
+    void Add(const FVector& Start, const FVector& End);
+
+    FORCEINLINE int32 Num() const
+    {
+        return StartX.Num();
+    }
+};
 
 /**
  * 
@@ -102,4 +167,36 @@ public:
         FVector& OutPointA,
         FVector& OutPointB
         );
+
+    // Batch variants, four elements per vector register with scalar
+    // processing of the remainder. Results match the scalar functions above.
+
+    // Squared distance between each segment and the segment Start-End
+    static void SegmentsDistSqToSegment(
+        const FGSSegmentSoA& Segments,
+        const FVector& Start,
+        const FVector& End,
+        TArray<float>& OutDistSq
+        );
+
+    // Batch CapsuleAndSweepSphereIntersection() of one swept sphere against every capsule,
+    // adds the indices of the intersecting capsules to OutHitIndices
+    static void SweepSphereAgainstCapsules(
+        const FGSCapsuleSoA& Capsules,
+        const FVector& SphereStart,
+        const FVector& SphereEnd,
+        float SphereRadius,
+        TArray<int32>& OutHitIndices
+        );
+
+    // Batch SweepCapsuleAndSphereIntersection() of every swept sphere against one swept capsule,
+    // adds the indices of the intersecting spheres to OutHitIndices
+    static void SweepSpheresAgainstCapsule(
+        const FGSSweptSphereSoA& Spheres,
+        const FVector& CapsuleStart,
+        const FVector& CapsuleEnd,
+        float CapsuleRadius,
+        float CapsuleHalfHeight,
+        TArray<int32>& OutHitIndices
+        );
 };
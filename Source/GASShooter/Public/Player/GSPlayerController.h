@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
 #include "Characters/GSCharacterBase.h"
+#include "UI/GSViewProjection.h"
 #include "GSPlayerController.generated.h"
 
 class UPaperSprite;
@@ -24,6 +25,7 @@ public:
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void Tick(float DeltaTime) override;
 
     void CreateHUD();
@@ -63,6 +65,12 @@ public:
     UFUNCTION(BlueprintCallable, Category = "GASShooter|UI")
     FVector2D GetProjectedAimScreenLocation();
 
+    // View projection snapshot of the current frame, built on aim input update
+    const FGSViewProjectionSnapshot& GetViewProjectionSnapshot() const
+    {
+        return ViewProjection;
+    }
+
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "GASShooter|Network")
 	int32 GetPing() const;
 
@@ -118,6 +126,10 @@ protected:
     UPROPERTY(BlueprintReadWrite, Category = "GASShooter|UI")
     class UGSHUDWidget* UIHUDWidget;
 
+    // Attribute values pushed to UIHUDWidget, flushed once per frame
+    UPROPERTY()
+    class UGSHUDViewModel* HUDViewModel;
+
     UPROPERTY(BlueprintReadOnly, EditDefaultsOnly)
     float CameraInterpSpeed = 1.0f;
 
@@ -135,6 +147,8 @@ protected:
 
     FVector2D ProjectedAimScreenLocation;
 
+    FGSViewProjectionSnapshot ViewProjection;
+
     //-----------------------------------------------
     // Perceived latency reduction
     /** Used to correct prediction error. */
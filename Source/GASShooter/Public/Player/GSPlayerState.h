@@ -47,6 +47,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "GASShooter|GSPlayerState|UI")
 	void StopInteractionTimer();
 
+	// Interaction prompt show/hide requests and the transitions that reached the HUD over the last second
+	UFUNCTION(BlueprintCallable, Category = "GASShooter|GSPlayerState|UI")
+	void GetInteractionPromptChurn(float& RequestedPerSecond, float& AppliedPerSecond) const;
+
 	/**
 	* Getters for attributes from GDAttributeSetBase. Returns Current Value unless otherwise specified.
 	*/
@@ -127,12 +131,49 @@ protected:
 	UPROPERTY()
 	class UGSAmmoAttributeSet* AmmoAttributeSet;
 
+	enum class EInteractionUIState : uint8
+	{
+		Hidden,
+		Prompt,
+		Timer
+	};
+
+	// Hiding the interaction prompt is delayed by this long so a target flickering between traces doesn't toggle it
+	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "GASShooter|GSPlayerState|UI")
+	float InteractionPromptHideDelay;
+
+	EInteractionUIState InteractionUIState;
+	float InteractionPromptDuration;
+	bool bPromptHidePending;
+
+	FTimerHandle InteractionPromptHideTimerHandle;
+
+	TWeakObjectPtr<class UGSHUDWidget> CachedHUDWidget;
+
+	// Interaction prompt churn counters
+	int32 NumRequestedPromptTransitions;
+	int32 NumAppliedPromptTransitions;
+	float PromptChurnWindowStartTime;
+	float RequestedPromptTransitionsPerSecond;
+	float AppliedPromptTransitionsPerSecond;
+
 	// Attribute changed delegate handles
 	FDelegateHandle HealthChangedDelegateHandle;
 
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	class UGSHUDWidget* GetHUDWidget();
+
+	void ApplyHideInteractionPrompt();
+
+	// Clears a delayed hide of the interaction prompt
+	void CancelPendingPromptHide();
+
+	void RecordPromptTransition(bool bApplied);
+
 	// Attribute changed callbacks
 	virtual void HealthChanged(const FOnAttributeChangeData& Data);
 
@@ -0,0 +1,141 @@
+// Copyright 2021 Nuraga Wiswakarma.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GSFloatingStatusBarOverlay.generated.h"
+
+class AGSCharacterBase;
+class APlayerController;
+class UCanvas;
+class UFont;
+struct FGSViewProjectionSnapshot;
+
+USTRUCT(BlueprintType)
+struct GASSHOOTER_API FGSFloatingStatusBarSettings
+{
+    GENERATED_BODY()
+
+    // World offset of the status bar from the character location
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FVector WorldOffset = FVector(0.0f, 0.0f, 120.0f);
+
+    // Status bars beyond this distance are culled
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float MaxDrawDistance = 6000.0f;
+
+    // Status bars within this distance refresh values and occlusion every frame
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float NearDistance = 1500.0f;
+
+    // Value and occlusion refresh interval at max draw distance,
+    // interpolated from every frame at near distance
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float FarUpdateInterval = 0.25f;
+
+    // Cull status bars of characters hidden behind world geometry
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bOcclusionCulling = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TEnumAsByte<ECollisionChannel> OcclusionTraceChannel = ECC_Visibility;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FVector2D BarSize = FVector2D(100.0f, 8.0f);
+
+    // Height of the shield and mana bars below the health bar
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float SecondaryBarHeight = 4.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float BarSpacing = 2.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FLinearColor BackgroundColor = FLinearColor(0.0f, 0.0f, 0.0f, 0.5f);
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FLinearColor HealthColor = FLinearColor(0.8f, 0.05f, 0.05f, 1.0f);
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FLinearColor ShieldColor = FLinearColor(0.1f, 0.5f, 1.0f, 1.0f);
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FLinearColor ManaColor = FLinearColor(0.2f, 0.2f, 0.9f, 1.0f);
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FLinearColor NameColor = FLinearColor::White;
+
+    // Uses the engine small font if not set
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    UFont* NameFont = nullptr;
+};
+
+/**
+ * Draws floating status bars of every registered character in a single
+ * canvas pass.
+ *
+ * Bars are drawn layer by layer (backgrounds, fills, names) so consecutive
+ * tiles share texture and blend mode and end up in the same canvas batch.
+ * Attribute values and occlusion are polled with an update interval that
+ * grows with distance instead of per character attribute callbacks.
+ */
+class GASSHOOTER_API FGSFloatingStatusBarOverlay
+{
+public:
+
+    void Register(AGSCharacterBase* Character, const FText& Name);
+
+    void Unregister(AGSCharacterBase* Character);
+
+    bool IsRegistered(const AGSCharacterBase* Character) const;
+
+    void Reset();
+
+    void Draw(
+        UCanvas* Canvas,
+        const FGSViewProjectionSnapshot& ViewProjection,
+        const APlayerController* PlayerController,
+        const FGSFloatingStatusBarSettings& Settings
+        );
+
+    FORCEINLINE int32 GetNumRegistered() const
+    {
+        return Entries.Num();
+    }
+
+private:
+
+    struct FEntry
+    {
+        TWeakObjectPtr<AGSCharacterBase> Character;
+
+        FText Name;
+
+        float HealthPercentage = 0.0f;
+        float ManaPercentage = 0.0f;
+        float ShieldPercentage = 0.0f;
+
+        float NextUpdateTime = 0.0f;
+        bool bOccluded = false;
+    };
+
+    struct FVisibleBar
+    {
+        FVector2D Position;
+        int32 EntryIndex;
+    };
+
+    TArray<FEntry> Entries;
+
+    // Scratch list of the bars visible this frame
+    TArray<FVisibleBar> VisibleBars;
+
+    void UpdateEntry(
+        FEntry& Entry,
+        AGSCharacterBase* Character,
+        const FVector& ViewLocation,
+        const FVector& BarLocation,
+        const APlayerController* PlayerController,
+        const FGSFloatingStatusBarSettings& Settings
+        );
+};
@@ -1,32 +0,0 @@
-// Copyright 2020 Dan Kestranek.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Blueprint/UserWidget.h"
-#include "GSFloatingStatusBarWidget.generated.h"
-
-/**
- * 
- */
-UCLASS()
-class GASSHOOTER_API UGSFloatingStatusBarWidget : public UUserWidget
-{
-	GENERATED_BODY()
-	
-public:
-	UPROPERTY(BlueprintReadOnly)
-	class AGSCharacterBase* OwningCharacter;
-
-	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable)
-	void SetHealthPercentage(float HealthPercentage);
-
-	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable)
-	void SetManaPercentage(float ManaPercentage);
-
-	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable)
-	void SetShieldPercentage(float ShieldPercentage);
-
-	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable)
-	void SetCharacterName(const FText& NewName);
-};
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/HUD.h"
+#include "UI/GSFloatingStatusBarOverlay.h"
+#include "UI/GSViewProjection.h"
 #include "GSHUD.generated.h"
 
 /**
@@ -16,6 +18,17 @@ class GASSHOOTER_API AGSHUD : public AHUD
 	
 public:
 
+	virtual void BeginPlay() override;
+
+	virtual void DrawHUD() override;
+
+	// Adds the character to the batched floating status bar overlay
+	void RegisterFloatingStatusBar(class AGSCharacterBase* Character, const FText& Name);
+
+	void UnregisterFloatingStatusBar(class AGSCharacterBase* Character);
+
+	bool IsFloatingStatusBarRegistered(const class AGSCharacterBase* Character) const;
+
 	UFUNCTION(BlueprintCallable)
 	void ProjectBoundsByExtents(
         const FVector& Origin,
@@ -35,4 +48,17 @@ public:
         FVector2D& OutScreenBR,
         FVector2D& OutScreenBL
         );
+
+protected:
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GASShooter|UI")
+	FGSFloatingStatusBarSettings FloatingStatusBarSettings;
+
+	// Canvas view projection, rebuilt once per frame on first use
+	FGSViewProjectionSnapshot CanvasViewProjection;
+
+	FGSFloatingStatusBarOverlay FloatingStatusBars;
+
+	// Returns whether the canvas view projection is valid for this frame
+	bool UpdateCanvasViewProjection();
 };
@@ -0,0 +1,84 @@
+// Copyright 2021 Nuraga Wiswakarma.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "GameplayEffectTypes.h"
+#include "Characters/Abilities/GSAbilityListenerHub.h"
+#include "GSHUDViewModel.generated.h"
+
+class UAbilitySystemComponent;
+class UGSAbilitySystemComponent;
+class UGSHUDWidget;
+
+/**
+ * Native view model of the HUD attribute values.
+ *
+ * Subscribes once to the ability system listener hub and only marks
+ * changed attributes as dirty. Dirty values are pushed to the HUD widget
+ * in a single flush per frame.
+ */
+UCLASS()
+class GASSHOOTER_API UGSHUDViewModel : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	enum EHUDAttribute : uint8
+	{
+		Health,
+		MaxHealth,
+		HealthRegenRate,
+		Mana,
+		MaxMana,
+		ManaRegenRate,
+		Stamina,
+		MaxStamina,
+		StaminaRegenRate,
+		Shield,
+		MaxShield,
+		ShieldRegenRate,
+		XP,
+		Gold,
+		CharacterLevel,
+		NumAttributes
+	};
+
+	// Subscribes to attribute changes of the specified ability system, marks every value dirty
+	void Bind(UAbilitySystemComponent* InAbilitySystemComponent);
+
+	void Unbind();
+
+	bool IsBound() const;
+
+	FORCEINLINE bool IsDirty() const
+	{
+		return DirtyMask != 0;
+	}
+
+	void MarkAllDirty();
+
+	// Pushes dirty values to the widget and clears dirty state
+	void Flush(UGSHUDWidget* Widget);
+
+protected:
+
+	TWeakObjectPtr<UGSAbilitySystemComponent> AbilitySystemComponent;
+
+	FGameplayAttribute Attributes[NumAttributes];
+
+	FGSListenerHandle ListenerHandle;
+
+	uint32 DirtyMask = 0;
+
+	void AttributeChanged(const FGameplayAttribute& Attribute, float NewValue, float OldValue);
+
+	float GetAttributeValue(EHUDAttribute Attribute) const;
+
+	FORCEINLINE bool IsAttributeDirty(uint32 Mask, EHUDAttribute Attribute) const
+	{
+		return (Mask & (1u << Attribute)) != 0;
+	}
+};
@@ -0,0 +1,56 @@
+// Copyright 2021 Nuraga Wiswakarma.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class APlayerController;
+class FSceneView;
+
+/**
+ * Per-frame view projection snapshot.
+ *
+ * Built once from the local player projection data (or a canvas scene view)
+ * so repeated world/screen projections don't re-resolve the local player,
+ * viewport and scene view for every call.
+ */
+struct GASSHOOTER_API FGSViewProjectionSnapshot
+{
+    FMatrix ViewProjectionMatrix = FMatrix::Identity;
+    FMatrix InvViewProjectionMatrix = FMatrix::Identity;
+
+    // Constrained player view rect in viewport pixels
+    FIntRect ViewRect;
+
+    // Viewport size (no DPI scale) and DPI scale
+    FVector2D ViewportSize = FVector2D::ZeroVector;
+    float ViewportScale = 1.0f;
+
+    uint64 FrameNumber = 0;
+    bool bIsValid = false;
+
+    // Builds snapshot from the player controller local player projection data
+    bool Build(const APlayerController* PlayerController);
+
+    // Builds snapshot from a canvas scene view, viewport size is the canvas size
+    bool Build(const FSceneView* SceneView, const FVector2D& CanvasSize);
+
+    FORCEINLINE bool IsCurrent() const
+    {
+        return bIsValid && FrameNumber == GFrameCounter;
+    }
+
+    // Same result as UGameplayStatics::ProjectWorldToScreen() with player viewport relative position
+    bool ProjectWorldToScreen(const FVector& WorldLocation, FVector2D& OutScreenLocation) const;
+
+    // Projects to canvas space (same as AHUD::Project()), fails behind the view
+    bool ProjectWorldToCanvas(const FVector& WorldLocation, FVector2D& OutCanvasLocation) const;
+
+    // Same result as UGameplayStatics::DeprojectScreenToWorld()
+    bool DeprojectScreenToWorld(const FVector2D& ScreenLocation, FVector& OutWorldLocation, FVector& OutWorldDirection) const;
+
+    // Projects the eight corners of an axis aligned box with a single
+    // origin transform and returns screen bounds in canvas space
+    // (same as AHUD::Project() for each corner).
+    FBox2D ProjectBoxBounds(const FVector& Origin, const FVector& Extents) const;
+};
@@ -8,6 +8,20 @@
 #include "Characters/Abilities/GSAbilityTypes.h"
 #include "GSUTProjectile.generated.h"
 
+/** Quantization used by FRepGSUTProjMovement */
+UENUM(BlueprintType)
+enum class EGSProjMovementQuantization : uint8
+{
+    /** Location, rotation and velocity at full replicated precision */
+    Default         UMETA(DisplayName = "Default"),
+    /** Velocity as 16-bit pitch/yaw direction plus packed integer magnitude,
+     * rotation derived from velocity if the movement rotation follows velocity */
+    Compressed      UMETA(DisplayName = "Compressed"),
+    /** Only the launch state (FRepGSUTProjLaunch) and the compressed final state are replicated,
+     * simulated proxies replay the trajectory locally. For projectiles whose path clients can reproduce */
+    BallisticReplay UMETA(DisplayName = "Ballistic Replay")
+};
+
 /** Replicated movement data of our RootComponent.
 * More efficient than engine's FRepMovement
 */
@@ -25,10 +39,20 @@ struct FRepGSUTProjMovement
     UPROPERTY()
     FRotator Rotation;
 
+    /** Quantization mode, set from the owning projectile class */
+    UPROPERTY()
+    EGSProjMovementQuantization Quantization;
+
+    /** If true, rotation is not sent and is rebuilt from velocity (compressed modes only) */
+    UPROPERTY()
+    bool bRotationFromVelocity;
+
     FRepGSUTProjMovement()
         : LinearVelocity(ForceInit)
         , Location(ForceInit)
         , Rotation(ForceInit)
+        , Quantization(EGSProjMovementQuantization::Default)
+        , bRotationFromVelocity(false)
     {}
 
     bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
@@ -37,12 +61,59 @@ struct FRepGSUTProjMovement
 
         bool bOutSuccessLocal = true;
 
-        // update location, linear velocity
+        uint8 QuantizationBits = static_cast<uint8>(Quantization);
+        Ar.SerializeBits(&QuantizationBits, 2);
+        Quantization = static_cast<EGSProjMovementQuantization>(QuantizationBits);
+
+        // update location
         Location.NetSerialize(Ar, Map, bOutSuccessLocal);
         bOutSuccess &= bOutSuccessLocal;
-        Rotation.SerializeCompressed(Ar);
-        LinearVelocity.NetSerialize(Ar, Map, bOutSuccessLocal);
-        bOutSuccess &= bOutSuccessLocal;
+
+        if (Quantization == EGSProjMovementQuantization::Default)
+        {
+            Rotation.SerializeCompressed(Ar);
+            LinearVelocity.NetSerialize(Ar, Map, bOutSuccessLocal);
+            bOutSuccess &= bOutSuccessLocal;
+            return true;
+        }
+
+        // velocity as fixed-point direction plus magnitude, packed so common speeds take two bytes
+        uint16 DirPitch = 0;
+        uint16 DirYaw = 0;
+        uint32 Speed = 0;
+
+        if (Ar.IsSaving())
+        {
+            const FRotator VelocityDir = LinearVelocity.Rotation();
+            DirPitch = FRotator::CompressAxisToShort(VelocityDir.Pitch);
+            DirYaw = FRotator::CompressAxisToShort(VelocityDir.Yaw);
+            Speed = static_cast<uint32>(FMath::RoundToInt(LinearVelocity.Size()));
+        }
+
+        Ar << DirPitch;
+        Ar << DirYaw;
+        Ar.SerializeIntPacked(Speed);
+
+        // a stopped projectile has no velocity direction, send its rotation instead
+        uint8 bRotationFromVelocityBit = (bRotationFromVelocity && Speed > 0) ? 1 : 0;
+        Ar.SerializeBits(&bRotationFromVelocityBit, 1);
+        bRotationFromVelocity = (bRotationFromVelocityBit != 0);
+
+        if (!bRotationFromVelocity)
+        {
+            Rotation.SerializeCompressed(Ar);
+        }
+
+        if (Ar.IsLoading())
+        {
+            const FRotator VelocityDir(FRotator::DecompressAxisFromShort(DirPitch), FRotator::DecompressAxisFromShort(DirYaw), 0.f);
+            LinearVelocity = VelocityDir.Vector() * Speed;
+
+            if (bRotationFromVelocity)
+            {
+                Rotation = VelocityDir;
+            }
+        }
 
         return true;
     }
@@ -63,6 +134,11 @@ struct FRepGSUTProjMovement
         {
             return false;
         }
+
+        if (Quantization != Other.Quantization || bRotationFromVelocity != Other.bRotationFromVelocity)
+        {
+            return false;
+        }
         return true;
     }
 
@@ -72,6 +148,47 @@ struct FRepGSUTProjMovement
     }
 };
 
+template<>
+struct TStructOpsTypeTraits<FRepGSUTProjMovement> : public TStructOpsTypeTraitsBase2<FRepGSUTProjMovement>
+{
+    enum
+    {
+        WithNetSerializer = true
+    };
+};
+
+/** Launch state of a projectile, replicated once for deterministic ballistic replay on simulated proxies */
+USTRUCT()
+struct FRepGSUTProjLaunch
+{
+    GENERATED_USTRUCT_BODY()
+
+    /** Server world time the projectile trajectory starts from */
+    UPROPERTY()
+    float ServerSpawnTime;
+
+    UPROPERTY()
+    FVector_NetQuantize Origin;
+
+    UPROPERTY()
+    FVector_NetQuantize10 Velocity;
+
+    UPROPERTY()
+    float GravityScale;
+
+    FRepGSUTProjLaunch()
+        : ServerSpawnTime(-1.f)
+        , Origin(ForceInit)
+        , Velocity(ForceInit)
+        , GravityScale(0.f)
+    {}
+
+    bool IsValid() const
+    {
+        return ServerSpawnTime >= 0.f;
+    }
+};
+
 UCLASS(meta = (ChildCanTick))
 class GASSHOOTER_API AGSUTProjectile : public AActor//, public IUTResetInterface, public IUTTeamInterface
 {
@@ -89,6 +206,53 @@ class GASSHOOTER_API AGSUTProjectile : public AActor//, public IUTResetInterface
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Replication)
     bool bReplicateUTMovement;
 
+    /** Quantization of GSUTProjReplicatedMovement for this projectile class */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Replication)
+    EGSProjMovementQuantization RepMovementQuantization;
+
+    /** True if only the launch state is replicated and simulated proxies replay the trajectory locally.
+     * Movement is replicated again only once the projectile explodes. */
+    bool UsesBallisticReplay() const
+    {
+        return RepMovementQuantization == EGSProjMovementQuantization::BallisticReplay;
+    }
+
+    /** Fixed time step used to replay trajectories that have no closed-form solution (bounce, homing, speed clamp) */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Replication, meta = (EditCondition = "RepMovementQuantization == EGSProjMovementQuantization::BallisticReplay", ClampMin = "0.001"))
+    float BallisticReplayStep;
+
+    /** Launch state for ballistic replay */
+    UPROPERTY(ReplicatedUsing = OnRep_GSUTProjLaunch)
+    FRepGSUTProjLaunch GSUTProjLaunch;
+
+    /** True while a simulated proxy is replaying its trajectory from GSUTProjLaunch */
+    bool bBallisticReplayActive;
+
+    /** True once the replay fell back to fixed-step integration */
+    bool bBallisticReplayIntegrating;
+
+    /** Trajectory time already simulated by the fixed-step replay */
+    float BallisticReplayTime;
+
+    UFUNCTION()
+    virtual void OnRep_GSUTProjLaunch();
+
+    /** Record the launch state on the server for ballistic replay */
+    virtual void InitBallisticLaunch();
+
+    /** Move the launch time back by DeltaTime, used when the server forward ticks the projectile */
+    virtual void RewindBallisticLaunch(float DeltaTime);
+
+    /** Advance the simulated proxy along the replicated trajectory to the current server time */
+    virtual void TickBallisticReplay();
+
+    /** Server world time on the server now. The client's replicated server time lags by the one-way latency,
+     * it is moved forward by the local player's prediction time like CatchupTick() of regular projectiles. */
+    float GetBallisticReplayServerTime() const;
+
+    /** Stop replaying and return to regular projectile movement */
+    virtual void StopBallisticReplay();
+
     /** How long projectile stays slowed down. */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Projectile)
     float SlomoTime;
@@ -358,6 +522,12 @@ class GASSHOOTER_API AGSUTProjectile : public AActor//, public IUTResetInterface
     UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = Projectile)
     void Explode(const FVector& HitLocation, const FVector& HitNormal, UPrimitiveComponent* HitComp = NULL);
 
+    /** Apply GameplayEffectSpecs to every damageable character within the explosion radius (server only).
+     * Victims are gathered with a single overlap query, occlusion traces are run as one batch
+     * and all visible victims are added to one container spec that is applied in a single pass.
+     * ImpactedActor is skipped since it was already damaged directly. Returns the number of characters damaged. */
+    virtual int32 ApplyRadialDamage(const FVector& Origin, const FVector& HitNormal, const FRadialDamageParams& InDamageParams);
+
     /** Whether this projectile always interacts with other projectiles */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Projectile)
     bool bAlwaysShootable;
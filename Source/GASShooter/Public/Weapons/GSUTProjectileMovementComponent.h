@@ -30,6 +30,10 @@ class GASSHOOTER_API UGSUTProjectileMovementComponent : public UProjectileMoveme
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Projectile, Meta = (EditCondition = "!bBounce"))
     float HitZStopSimulatingThreshold;
 
+    /** Max time step used by CatchupTick() when simulating network latency catch-up in one go */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Projectile, meta = (ClampMin = "0.001"))
+    float MaxCatchupStep;
+
     /** additional components that should be moved along with the main UpdatedComponent. Defaults to all colliding children of UpdatedComponent.
      * closest blocking hit of all components is used for blocking collision
      *
@@ -54,6 +58,21 @@ class GASSHOOTER_API UGSUTProjectileMovementComponent : public UProjectileMoveme
 
     virtual void SetUpdatedComponent(USceneComponent* NewUpdatedComponent) override;
 
+    /** Simulate DeltaTime seconds in sub-steps of at most MaxCatchupStep.
+     * Overlaps are dispatched after every step so pawn hits happen where the projectile reaches the pawn.
+     * Stops early if the projectile stops simulating (impact, explosion or destruction).
+     * Returns the simulated time. */
+    float CatchupTick(float DeltaTime);
+
+    /** Returns true if the trajectory may have a closed-form solution:
+     * no bounce, no homing, no explicit acceleration and not both gravity and AccelRate */
+    bool HasClosedFormTrajectory() const;
+
+    /** Closed-form location and velocity after Time seconds from Origin with InitialVelocity.
+     * Returns false if the path can't be solved in closed form (e.g. gravity pushes speed above MaxSpeed),
+     * in which case the projectile has to be integrated. */
+    bool EvaluateClosedFormTrajectory(const FVector& Origin, const FVector& InitialVelocity, float Time, FVector& OutLocation, FVector& OutVelocity) const;
+
     // public access to HandleImpact() for handling hits caused by other actors (e.g. lifts) that we want to process as if the projectile move caused the impact
     void SimulateImpact(const FHitResult& Hit)
     {
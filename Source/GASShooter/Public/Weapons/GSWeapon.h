@@ -36,10 +36,15 @@ struct FGSDelayedProjectileInfo
     UPROPERTY()
     FRotator SpawnRotation;
 
+    /** World time at which this projectile should be spawned. */
+    UPROPERTY()
+    float SpawnTime;
+
     FGSDelayedProjectileInfo()
         : ProjectileClass(NULL)
         , SpawnLocation(ForceInit)
         , SpawnRotation(ForceInit)
+        , SpawnTime(0.f)
     {}
 };
 
@@ -359,9 +364,21 @@ protected:
     FGameplayTag WeaponAlternateInstantAbilityTag;
     FGameplayTag WeaponIsFiringTag;
 
-    /** Delayed projectile information */
+    /** Max number of delayed fake projectiles waiting to be spawned.
+     * Size of the delayed projectile ring buffer, allocated once on BeginPlay. */
+    UPROPERTY(EditDefaultsOnly, Category = "GASShooter|GSWeapon")
+    int32 MaxDelayedProjectiles;
+
+    /** Delayed projectile ring buffer, sorted by SpawnTime (the due time) on insertion.
+     * SleepTime varies with ping, so entries are not necessarily queued in due order. */
     UPROPERTY()
-    FGSDelayedProjectileInfo DelayedProjectile;
+    TArray<FGSDelayedProjectileInfo> DelayedProjectiles;
+
+    /** Index of the delayed projectile due first in the ring buffer */
+    int32 DelayedProjectileHead;
+
+    /** Number of pending delayed projectiles in the ring buffer */
+    int32 DelayedProjectileCount;
 
     FTimerHandle SpawnDelayedFakeProjHandle;
 
@@ -380,9 +397,21 @@ protected:
         bool bDeferForwardTick
         );
 
+    /** Queue a delayed projectile to be spawned after SleepTime. */
+    void QueueDelayedFakeProjectile(
+        TSubclassOf<AGSUTProjectile> ProjectileClass,
+        FVector SpawnLocation,
+        FRotator SpawnRotation,
+        float SleepTime
+        );
+
+    /** Spawn every queued delayed projectile that is due
+     * and schedule the timer for the next pending one. */
+    void ProcessDelayedFakeProjectiles();
+
     /** Spawn a delayed projectile,
      * delayed because client ping above max forward prediction limit. */
-    virtual void SpawnDelayedFakeProjectile();
+    virtual void SpawnDelayedFakeProjectile(const FGSDelayedProjectileInfo& DelayedProjectile);
 
     UFUNCTION()
     virtual void OnRep_PrimaryClipAmmo(int32 OldPrimaryClipAmmo);